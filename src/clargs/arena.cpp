@@ -0,0 +1,85 @@
+/*
+MIT License
+
+Copyright (c) 2018-2023 Ivan Gagis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+#include "arena.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#include <utki/debug.hpp>
+
+using namespace clargs;
+
+void* arena::allocate(
+	size_t size, //
+	size_t alignment
+)
+{
+	ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0)
+	ASSERT(alignment <= alignof(std::max_align_t))
+
+	auto padding = size_t(-reinterpret_cast<uintptr_t>(this->cur)) & (alignment - 1);
+
+	if (!this->cur || padding + size > this->num_free) {
+		if (size > max_block_size / 2) {
+			// big allocations get a block of their own, so that the rest of the current block is not wasted
+			this->blocks.emplace_back(new char[size]);
+			return this->blocks.back().get();
+		}
+
+		while (this->next_block_size < size) {
+			this->next_block_size *= 2;
+		}
+
+		this->blocks.emplace_back(new char[this->next_block_size]);
+		this->cur = this->blocks.back().get();
+		this->num_free = this->next_block_size;
+
+		if (this->next_block_size < max_block_size) {
+			this->next_block_size *= 2;
+		}
+
+		// new[] returns memory aligned for any fundamental type
+		padding = 0;
+	}
+
+	auto ret = this->cur + padding;
+	this->cur = ret + size;
+	this->num_free -= padding + size;
+
+	return ret;
+}
+
+std::string_view arena::copy(std::string_view str)
+{
+	if (str.empty()) {
+		return {};
+	}
+
+	auto memory = static_cast<char*>(this->allocate(str.size(), 1));
+	std::memcpy(memory, str.data(), str.size());
+	return {memory, str.size()};
+}
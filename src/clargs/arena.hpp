@@ -0,0 +1,140 @@
+/*
+MIT License
+
+Copyright (c) 2018-2023 Ivan Gagis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace clargs {
+
+/**
+ * @brief Monotonic memory arena.
+ * Allocates memory from big blocks sequentially, the memory is only freed when the arena is destroyed.
+ * Used to store many small objects with the same lifetime, like strings and records of registered arguments,
+ * with just a handful of heap allocations.
+ */
+class arena
+{
+	std::vector<std::unique_ptr<char[]>> blocks;
+
+	char* cur = nullptr;
+	size_t num_free = 0;
+
+	size_t next_block_size = min_block_size;
+
+	constexpr static size_t min_block_size = 0x400;
+	constexpr static size_t max_block_size = 0x10000;
+
+public:
+	/**
+	 * @brief Destroyer of the objects created in the arena.
+	 * Only calls the object's destructor, the memory is freed by the arena.
+	 */
+	struct destroyer {
+		template <typename object_type>
+		void operator()(object_type* p) const noexcept
+		{
+			p->~object_type();
+		}
+	};
+
+	/**
+	 * @brief Owning pointer to an object created in the arena.
+	 * The pointer must be destroyed before the arena.
+	 */
+	template <typename object_type>
+	using pointer = std::unique_ptr<object_type, destroyer>;
+
+	arena() = default;
+
+	arena(const arena&) = delete;
+	arena& operator=(const arena&) = delete;
+
+	arena(arena&& a) noexcept :
+		blocks(std::move(a.blocks)),
+		cur(std::exchange(a.cur, nullptr)),
+		num_free(std::exchange(a.num_free, 0)),
+		next_block_size(std::exchange(a.next_block_size, min_block_size))
+	{}
+
+	/**
+	 * @brief Move assignment.
+	 * The memory of the arenas is swapped instead of freeing the memory of this arena,
+	 * so that the objects created in this arena can still be destroyed after the assignment,
+	 * as long as the moved from arena is alive.
+	 * @param a - arena to move from.
+	 * @return reference to this arena.
+	 */
+	arena& operator=(arena&& a) noexcept
+	{
+		std::swap(this->blocks, a.blocks);
+		std::swap(this->cur, a.cur);
+		std::swap(this->num_free, a.num_free);
+		std::swap(this->next_block_size, a.next_block_size);
+		return *this;
+	}
+
+	~arena() = default;
+
+	/**
+	 * @brief Allocate memory.
+	 * @param size - size of the memory to allocate.
+	 * @param alignment - alignment of the memory, must be a power of 2, not greater than alignof(std::max_align_t).
+	 * @return pointer to the allocated memory.
+	 */
+	void* allocate(
+		size_t size, //
+		size_t alignment
+	);
+
+	/**
+	 * @brief Copy string to the arena.
+	 * @param str - string to copy.
+	 * @return view of the copy.
+	 */
+	std::string_view copy(std::string_view str);
+
+	/**
+	 * @brief Create object in the arena.
+	 * @param args - arguments of the object's constructor.
+	 * @return owning pointer to the created object.
+	 */
+	template <typename object_type, typename... arguments_type>
+	pointer<object_type> make(arguments_type&&... args)
+	{
+		static_assert(alignof(object_type) <= alignof(std::max_align_t), "over-aligned types are not supported");
+
+		auto memory = this->allocate(sizeof(object_type), alignof(object_type));
+		return pointer<object_type>(new (memory) object_type(std::forward<arguments_type>(args)...));
+	}
+};
+
+} // namespace clargs
@@ -0,0 +1,118 @@
+/*
+MIT License
+
+Copyright (c) 2018-2023 Ivan Gagis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+#include "edit_distance.hpp"
+
+#include <utki/debug.hpp>
+
+using namespace clargs;
+
+edit_distance_matcher::edit_distance_matcher(std::string_view pattern) noexcept :
+	pattern_length(pattern.size())
+{
+	ASSERT(pattern.size() <= max_pattern_length)
+
+	for (size_t i = 0; i != pattern.size(); ++i) {
+		this->peq[static_cast<unsigned char>(pattern[i])] |= uint64_t(1) << i;
+	}
+}
+
+edit_distance_matcher::column edit_distance_matcher::first_column() const noexcept
+{
+	auto m = this->pattern_length;
+
+	// the first column is 0, 1, 2, ..., m
+	return column{
+		m == max_pattern_length ? ~uint64_t(0) : (uint64_t(1) << m) - 1, //
+		0,
+		m
+	};
+}
+
+edit_distance_matcher::column edit_distance_matcher::next_column(
+	const column& c, //
+	char ch
+) const noexcept
+{
+	auto m = this->pattern_length;
+	if (m == 0) {
+		return column{0, 0, c.distance + 1};
+	}
+
+	auto eq = this->peq[static_cast<unsigned char>(ch)];
+
+	auto xv = eq | c.mv;
+	auto xh = (((eq & c.pv) + c.pv) ^ c.pv) | eq;
+
+	auto ph = c.mv | ~(xh | c.pv);
+	auto mh = c.pv & xh;
+
+	column ret{0, 0, c.distance};
+
+	// last row bit
+	auto last = uint64_t(1) << (m - 1);
+	if (ph & last) {
+		++ret.distance;
+	} else if (mh & last) {
+		--ret.distance;
+	}
+
+	// the first row is 0, 1, 2, ..., n, so its horizontal delta is always positive
+	ph = (ph << 1) | 1;
+	mh <<= 1;
+
+	ret.pv = mh | ~(xv | ph);
+	ret.mv = ph & xv;
+
+	return ret;
+}
+
+size_t edit_distance_matcher::distance(
+	std::string_view str, //
+	size_t max_distance
+) const noexcept
+{
+	auto m = this->pattern_length;
+
+	// each edit changes the length by at most one
+	auto length_difference = m > str.size() ? m - str.size() : str.size() - m;
+	if (length_difference > max_distance) {
+		return max_distance + 1;
+	}
+
+	auto c = this->first_column();
+
+	for (size_t i = 0; i != str.size(); ++i) {
+		c = this->next_column(c, str[i]);
+
+		// the distance decreases at most by one per each remaining character
+		if (c.distance > max_distance + (str.size() - i - 1)) {
+			return max_distance + 1;
+		}
+	}
+
+	return c.distance > max_distance ? max_distance + 1 : c.distance;
+}
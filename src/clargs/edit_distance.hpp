@@ -0,0 +1,111 @@
+/*
+MIT License
+
+Copyright (c) 2018-2023 Ivan Gagis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+namespace clargs {
+
+/**
+ * @brief Bounded Levenshtein distance to a fixed pattern.
+ * Computes edit distance between the pattern and given strings with the Myers' bit-parallel algorithm,
+ * in Hyyrö's formulation for the whole strings comparison. Each column of the dynamic programming matrix
+ * is kept as bit vectors of vertical deltas, so each character of the compared string is processed
+ * with a few word operations, regardless of the pattern length.
+ * The pattern is preprocessed once, so that comparing it to many strings only costs the comparisons.
+ * The columns can be kept by the caller, so that strings having common prefix are compared
+ * without processing the prefix again.
+ */
+class edit_distance_matcher
+{
+	// for each character, bit i is set in case the pattern character i is equal to it
+	std::array<uint64_t, std::numeric_limits<unsigned char>::max() + 1> peq = {};
+
+	size_t pattern_length;
+
+public:
+	/**
+	 * @brief Maximum pattern length.
+	 */
+	constexpr static size_t max_pattern_length = std::numeric_limits<uint64_t>::digits;
+
+	/**
+	 * @brief Constructor.
+	 * @param pattern - pattern to compare strings to, must not be longer than max_pattern_length.
+	 */
+	explicit edit_distance_matcher(std::string_view pattern) noexcept;
+
+	/**
+	 * @brief Column of the dynamic programming matrix.
+	 * Represents edit distances between all prefixes of the pattern and a string.
+	 */
+	struct column {
+		// positive and negative vertical deltas
+		uint64_t pv;
+		uint64_t mv;
+
+		/**
+		 * @brief Edit distance between the whole pattern and the string.
+		 */
+		size_t distance;
+	};
+
+	/**
+	 * @brief Get column of the empty string.
+	 * @return column of the empty string.
+	 */
+	column first_column() const noexcept;
+
+	/**
+	 * @brief Get column of the string appended with a character.
+	 * @param c - column of a string.
+	 * @param ch - character to append to the string.
+	 * @return column of the string appended with the character.
+	 */
+	column next_column(
+		const column& c, //
+		char ch
+	) const noexcept;
+
+	/**
+	 * @brief Compute edit distance between the pattern and the string.
+	 * The computation stops as soon as the distance cannot fit the given bound.
+	 * @param str - string to compare the pattern to.
+	 * @param max_distance - maximum distance of interest.
+	 * @return edit distance between the pattern and the string, in case it is not greater than max_distance.
+	 * @return max_distance + 1 otherwise.
+	 */
+	size_t distance(
+		std::string_view str, //
+		size_t max_distance
+	) const noexcept;
+};
+
+} // namespace clargs
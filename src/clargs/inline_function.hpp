@@ -0,0 +1,309 @@
+/*
+MIT License
+
+Copyright (c) 2018-2023 Ivan Gagis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+#pragma once
+
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <utki/debug.hpp>
+
+namespace clargs {
+
+/**
+ * @brief Non-owning reference to a callable object.
+ * Lightweight alternative to std::function for cases when the referred callable object is known to outlive the reference.
+ * Since it is just a pair of pointers, it is always stored inline by the inline_function,
+ * so it can be used to register argument handlers without any memory allocations.
+ * @tparam signature - signature of the callable, e.g. void(std::string_view).
+ */
+template <typename signature>
+class function_ref;
+
+template <typename return_type, typename... argument_types>
+class function_ref<return_type(argument_types...)>
+{
+	void* callable;
+	return_type (*invoker)(void* callable, argument_types... args);
+
+	template <typename callable_type>
+	static return_type invoke(
+		void* callable, //
+		argument_types... args
+	)
+	{
+		return std::invoke(*static_cast<callable_type*>(callable), std::forward<argument_types>(args)...);
+	}
+
+public:
+	/**
+	 * @brief Constructor.
+	 * @param callable - callable object to refer to. Must outlive the function_ref and all its copies.
+	 */
+	template <
+		typename callable_type,
+		std::enable_if_t<
+			std::is_object_v<callable_type> && !std::is_same_v<std::remove_cv_t<callable_type>, function_ref> &&
+				std::is_invocable_r_v<return_type, callable_type&, argument_types...>,
+			bool> = true>
+	// NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
+	function_ref(callable_type& callable) noexcept :
+		callable(const_cast<void*>(static_cast<const void*>(std::addressof(callable)))),
+		invoker(&invoke<callable_type>)
+	{}
+
+	return_type operator()(argument_types... args) const
+	{
+		return this->invoker(this->callable, std::forward<argument_types>(args)...);
+	}
+};
+
+constexpr size_t default_inline_function_buffer_size = 2 * sizeof(void*);
+
+/**
+ * @brief Move-only function wrapper with inline storage.
+ * Alternative to std::function. The callable object is stored inside of the inline_function object
+ * in case it fits into the buffer of buffer_size bytes, otherwise it is allocated on the heap.
+ * Trivially copyable callables, like lambdas capturing only references and pointers, and function_ref,
+ * are moved by just copying the buffer.
+ * As std::function does, constructing from a null function pointer or an empty std::function
+ * produces an empty inline_function.
+ * @tparam signature - signature of the callable, e.g. void(std::string_view).
+ * @tparam buffer_size - size of the inline buffer in bytes.
+ */
+template <typename signature, size_t buffer_size = default_inline_function_buffer_size>
+class inline_function;
+
+template <typename return_type, typename... argument_types, size_t buffer_size>
+class inline_function<return_type(argument_types...), buffer_size>
+{
+	static_assert(buffer_size >= sizeof(void*), "buffer must be big enough to hold a pointer");
+
+	enum class operation {
+		move,
+		destroy
+	};
+
+	using invoker_type = return_type (*)(void* callable, argument_types... args);
+
+	// moves the callable from one buffer to another and destroys the moved from callable,
+	// or just destroys the callable, the buffers are never the same
+	using manager_type = void (*)(operation op, void* from, void* to);
+
+	alignas(void*) mutable char buffer[buffer_size] = {};
+
+	invoker_type invoker = nullptr;
+
+	// nullptr in case the callable is trivially copyable
+	manager_type manager = nullptr;
+
+	template <typename callable_type>
+	constexpr static bool is_stored_inline = sizeof(callable_type) <= buffer_size &&
+		alignof(callable_type) <= alignof(void*) && std::is_nothrow_move_constructible_v<callable_type>;
+
+	template <typename callable_type>
+	constexpr static bool is_trivial = std::is_trivially_copyable_v<callable_type> &&
+		std::is_trivially_destructible_v<callable_type>;
+
+	template <typename>
+	struct is_std_function : std::false_type {};
+
+	template <typename function_signature>
+	struct is_std_function<std::function<function_signature>> : std::true_type {};
+
+	template <typename callable_type>
+	constexpr static bool is_nullable = std::is_pointer_v<callable_type> ||
+		std::is_member_pointer_v<callable_type> || is_std_function<callable_type>::value;
+
+	template <typename callable_type>
+	static return_type call(
+		callable_type& callable, //
+		argument_types&&... args
+	)
+	{
+		if constexpr (std::is_void_v<return_type>) {
+			std::invoke(callable, std::forward<argument_types>(args)...);
+		} else {
+			return std::invoke(callable, std::forward<argument_types>(args)...);
+		}
+	}
+
+	template <typename callable_type>
+	static return_type invoke_inline(
+		void* callable, //
+		argument_types... args
+	)
+	{
+		return call(*static_cast<callable_type*>(callable), std::forward<argument_types>(args)...);
+	}
+
+	template <typename callable_type>
+	static return_type invoke_heap(
+		void* callable, //
+		argument_types... args
+	)
+	{
+		return call(**static_cast<callable_type**>(callable), std::forward<argument_types>(args)...);
+	}
+
+	template <typename callable_type>
+	static void manage_inline(
+		operation op, //
+		void* from,
+		void* to
+	)
+	{
+		auto c = static_cast<callable_type*>(from);
+		if (op == operation::move) {
+			new (to) callable_type(std::move(*c));
+		}
+		c->~callable_type();
+	}
+
+	template <typename callable_type>
+	static void manage_heap(
+		operation op, //
+		void* from,
+		void* to
+	)
+	{
+		auto c = static_cast<callable_type**>(from);
+		if (op == operation::move) {
+			new (to) callable_type*(*c);
+		} else {
+			delete *c;
+		}
+	}
+
+	void take(inline_function& f) noexcept
+	{
+		this->invoker = std::exchange(f.invoker, nullptr);
+		this->manager = std::exchange(f.manager, nullptr);
+
+		if (this->manager) {
+			this->manager(operation::move, f.buffer, this->buffer);
+		} else if (this->invoker) {
+			std::memcpy(this->buffer, f.buffer, buffer_size);
+		}
+	}
+
+public:
+	inline_function() noexcept = default;
+
+	// NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
+	inline_function(std::nullptr_t) noexcept {}
+
+	/**
+	 * @brief Constructor.
+	 * @param callable - callable object to store.
+	 */
+	template <
+		typename callable_type,
+		typename decayed_type = std::decay_t<callable_type>,
+		std::enable_if_t<
+			!std::is_same_v<decayed_type, inline_function> &&
+				std::is_invocable_r_v<return_type, decayed_type&, argument_types...>,
+			bool> = true>
+	// NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
+	inline_function(callable_type&& callable)
+	{
+		if constexpr (is_nullable<decayed_type>) {
+			if (!callable) {
+				return;
+			}
+		}
+
+		if constexpr (is_stored_inline<decayed_type>) {
+			new (this->buffer) decayed_type(std::forward<callable_type>(callable));
+			this->invoker = &invoke_inline<decayed_type>;
+			if constexpr (!is_trivial<decayed_type>) {
+				this->manager = &manage_inline<decayed_type>;
+			}
+		} else {
+			new (this->buffer) decayed_type*(new decayed_type(std::forward<callable_type>(callable)));
+			this->invoker = &invoke_heap<decayed_type>;
+			this->manager = &manage_heap<decayed_type>;
+		}
+	}
+
+	inline_function(const inline_function&) = delete;
+	inline_function& operator=(const inline_function&) = delete;
+
+	inline_function(inline_function&& f) noexcept
+	{
+		this->take(f);
+	}
+
+	inline_function& operator=(inline_function&& f) noexcept
+	{
+		if (this != &f) {
+			this->reset();
+			this->take(f);
+		}
+		return *this;
+	}
+
+	inline_function& operator=(std::nullptr_t) noexcept
+	{
+		this->reset();
+		return *this;
+	}
+
+	~inline_function()
+	{
+		this->reset();
+	}
+
+	/**
+	 * @brief Destroy the stored callable.
+	 * The inline_function becomes empty.
+	 */
+	void reset() noexcept
+	{
+		if (this->manager) {
+			this->manager(operation::destroy, this->buffer, nullptr);
+		}
+		this->invoker = nullptr;
+		this->manager = nullptr;
+	}
+
+	explicit operator bool() const noexcept
+	{
+		return this->invoker != nullptr;
+	}
+
+	return_type operator()(argument_types... args) const
+	{
+		ASSERT(this->invoker)
+		return this->invoker(this->buffer, std::forward<argument_types>(args)...);
+	}
+};
+
+} // namespace clargs
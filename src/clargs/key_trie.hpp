@@ -0,0 +1,255 @@
+/*
+MIT License
+
+Copyright (c) 2018-2023 Ivan Gagis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <utki/span.hpp>
+
+namespace clargs {
+
+/**
+ * @brief Radix tree of string keys for prefix lookups.
+ * Maps string keys to pointers to values, same as lookup_table, but in addition to the exact
+ * key lookups it allows finding all the keys starting with a given prefix in a single walk,
+ * which takes time proportional to the prefix length.
+ * The tree is built at once from the given entries and cannot be modified afterwards.
+ * The nodes are stored in a single contiguous array, children of each node are stored next to each other
+ * in the order of the edge labels. The entries are stored sorted by key, so that the keys of each subtree
+ * form a contiguous range of the entries.
+ * The tree does not own neither the keys nor the values, those are held by some other container.
+ * @tparam value_type - type of values.
+ */
+template <typename value_type>
+class key_trie
+{
+public:
+	/**
+	 * @brief Key-value pair.
+	 */
+	struct entry {
+		std::string_view key;
+		value_type* value;
+	};
+
+private:
+	std::vector<entry> entries;
+
+	// for each entry, length of the common prefix of its key and the key of the previous entry
+	std::vector<uint32_t> common_prefix_lengths;
+
+	struct node {
+		// label of the edge leading to the node, a view into one of the keys
+		std::string_view label;
+
+		uint32_t first_child = 0;
+		uint32_t num_children = 0;
+
+		// range of the entries with the keys starting with the node prefix
+		uint32_t entries_begin = 0;
+		uint32_t entries_end = 0;
+	};
+
+	std::vector<node> nodes;
+
+	// the entries in the given range have common prefix of the given length,
+	// which is the prefix of the given node
+	void build_children(
+		size_t node_index, //
+		size_t prefix_length,
+		size_t begin,
+		size_t end
+	)
+	{
+		auto node_begin = begin;
+
+		// the key equal to the node prefix is the first one in the range, it does not go to the children
+		if (begin != end && this->entries[begin].key.size() == prefix_length) {
+			++begin;
+		}
+
+		auto first_child = this->nodes.size();
+
+		// group the entries by the character following the common prefix
+		for (size_t group_begin = begin; group_begin != end;) {
+			auto first_key = this->entries[group_begin].key;
+			char c = first_key[prefix_length];
+
+			auto group_end = group_begin + 1;
+			while (group_end != end && this->entries[group_end].key[prefix_length] == c) {
+				++group_end;
+			}
+
+			// the keys are sorted, so the common prefix of the group is the common prefix of its first and last keys
+			auto last_key = this->entries[group_end - 1].key;
+			auto mismatch = std::mismatch(
+				std::next(first_key.begin(), std::ptrdiff_t(prefix_length)),
+				first_key.end(),
+				std::next(last_key.begin(), std::ptrdiff_t(prefix_length)),
+				last_key.end()
+			);
+			auto label_length = size_t(std::distance(first_key.begin(), mismatch.first)) - prefix_length;
+
+			// the keys of different groups only have the node prefix in common,
+			// the common prefix of the first key of the node range is set by the parent node
+			if (group_begin != node_begin) {
+				this->common_prefix_lengths[group_begin] = uint32_t(prefix_length);
+			}
+
+			node child;
+			child.label = first_key.substr(prefix_length, label_length);
+			child.entries_begin = uint32_t(group_begin);
+			child.entries_end = uint32_t(group_end);
+			this->nodes.push_back(child);
+
+			group_begin = group_end;
+		}
+
+		auto num_children = this->nodes.size() - first_child;
+
+		this->nodes[node_index].first_child = uint32_t(first_child);
+		this->nodes[node_index].num_children = uint32_t(num_children);
+
+		for (auto i = first_child; i != first_child + num_children; ++i) {
+			const auto& child = this->nodes[i];
+			this->build_children(
+				i, //
+				prefix_length + child.label.size(),
+				child.entries_begin,
+				child.entries_end
+			);
+		}
+	}
+
+public:
+	/**
+	 * @brief Build the tree.
+	 * @param entries - key-value pairs, all keys must be unique and non-empty.
+	 *                  The key strings must outlive the tree.
+	 */
+	explicit key_trie(std::vector<entry> entries) :
+		entries(std::move(entries))
+	{
+		std::sort(
+			this->entries.begin(), //
+			this->entries.end(),
+			[](const entry& a, const entry& b) {
+				return a.key < b.key;
+			}
+		);
+
+		this->common_prefix_lengths.resize(this->entries.size(), 0);
+
+		node root;
+		root.entries_end = uint32_t(this->entries.size());
+		this->nodes.push_back(root);
+
+		// the tree has less nodes than twice the number of keys
+		this->nodes.reserve(this->entries.size() * 2);
+
+		this->build_children(0, 0, 0, this->entries.size());
+	}
+
+	/**
+	 * @brief Find entries by key prefix.
+	 * @param prefix - prefix to look up.
+	 * @return entries with the keys starting with the given prefix, sorted by key.
+	 *         In case one of the keys is equal to the prefix, then it is the first one.
+	 */
+	utki::span<const entry> find_prefix(std::string_view prefix) const noexcept
+	{
+		const node* n = this->nodes.data();
+
+		for (size_t pos = 0; pos != prefix.size();) {
+			auto children_begin = std::next(this->nodes.begin(), n->first_child);
+			auto children_end = std::next(children_begin, n->num_children);
+
+			auto child = std::lower_bound(
+				children_begin, //
+				children_end,
+				prefix[pos],
+				[](const node& c, char ch) {
+					// same order as of the sorted keys, where the characters are compared as unsigned
+					return std::char_traits<char>::lt(c.label.front(), ch);
+				}
+			);
+			if (child == children_end || child->label.front() != prefix[pos]) {
+				return {};
+			}
+
+			// the prefix can end in the middle of the edge label
+			auto length = std::min(child->label.size(), prefix.size() - pos);
+			if (prefix.substr(pos, length) != child->label.substr(0, length)) {
+				return {};
+			}
+
+			pos += length;
+			n = &*child;
+		}
+
+		return utki::make_span(
+			std::next(this->entries.data(), n->entries_begin), //
+			n->entries_end - n->entries_begin
+		);
+	}
+
+	/**
+	 * @brief Get all entries.
+	 * @return all entries, sorted by key.
+	 */
+	utki::span<const entry> get_entries() const noexcept
+	{
+		return this->entries;
+	}
+
+	/**
+	 * @brief Get length of the common prefix of the entry key and the previous entry key.
+	 * Allows processing the keys in sorted order without processing their common prefixes again.
+	 * @param index - index of the entry, as in get_entries().
+	 * @return length of the common prefix of the entry key and the previous entry key.
+	 * @return 0 for the first entry.
+	 */
+	size_t get_common_prefix_length(size_t index) const noexcept
+	{
+		return this->common_prefix_lengths[index];
+	}
+
+	/**
+	 * @brief Get number of keys in the tree.
+	 * @return number of keys in the tree.
+	 */
+	size_t size() const noexcept
+	{
+		return this->entries.size();
+	}
+};
+
+} // namespace clargs
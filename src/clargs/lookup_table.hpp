@@ -0,0 +1,190 @@
+/*
+MIT License
+
+Copyright (c) 2018-2023 Ivan Gagis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <string_view>
+#include <vector>
+
+namespace clargs {
+
+/**
+ * @brief Flat hash table of string keys.
+ * Open addressing hash table with linear probing which maps string keys to pointers to values.
+ * The table does not own neither the keys nor the values, those are held by some other container.
+ * The table grows automatically as the keys are inserted.
+ * All entries are stored in a single contiguous array together with precomputed hashes of the keys,
+ * so that a lookup is mostly a sequential scan of a few neighbouring entries.
+ * @tparam value_type - type of values.
+ */
+template <typename value_type>
+class lookup_table
+{
+	struct entry {
+		size_t hash;
+		std::string_view key;
+		value_type* value; // nullptr means empty entry
+	};
+
+	std::vector<entry> entries;
+
+	// entries.size() - 1, entries.size() is always a power of 2
+	size_t mask = 0;
+
+	size_t num_values = 0;
+
+	static size_t hash_of(std::string_view key) noexcept
+	{
+		return std::hash<std::string_view>()(key);
+	}
+
+	void insert(const entry& new_entry) noexcept
+	{
+		for (size_t i = new_entry.hash & this->mask;; i = (i + 1) & this->mask) {
+			auto& e = this->entries[i];
+			if (!e.value) {
+				e = new_entry;
+				++this->num_values;
+				return;
+			}
+		}
+	}
+
+	void grow()
+	{
+		std::vector<entry> old_entries(this->entries.size() * 2, entry{0, std::string_view(), nullptr});
+		std::swap(old_entries, this->entries);
+
+		this->mask = this->entries.size() - 1;
+		this->num_values = 0;
+
+		for (const auto& e : old_entries) {
+			if (e.value) {
+				this->insert(e);
+			}
+		}
+	}
+
+public:
+	/**
+	 * @brief Remove all entries and reserve space for given number of keys.
+	 * @param num_keys - number of keys which will be inserted to the table.
+	 */
+	void reset(size_t num_keys)
+	{
+		// keep load factor at most 0.5
+		size_t capacity = 2;
+		while (capacity < num_keys * 2) {
+			capacity *= 2;
+		}
+
+		this->entries.assign(capacity, entry{0, std::string_view(), nullptr});
+		this->mask = capacity - 1;
+		this->num_values = 0;
+	}
+
+	/**
+	 * @brief Insert key-value pair.
+	 * The key must not be present in the table.
+	 * In case there is not enough space reserved, the table grows twice.
+	 * @param key - key to insert. The key string must outlive the table.
+	 * @param value - value to insert.
+	 */
+	void insert(
+		std::string_view key, //
+		value_type& value
+	)
+	{
+		if (this->entries.empty()) {
+			this->reset(1);
+		} else if ((this->num_values + 1) * 2 > this->entries.size()) {
+			this->grow();
+		}
+
+		this->insert(entry{hash_of(key), key, &value});
+	}
+
+	/**
+	 * @brief Find value by key.
+	 * @param key - key to look up.
+	 * @return pointer to the value if the key is found.
+	 * @return nullptr if the key is not found.
+	 */
+	value_type* find(std::string_view key) const noexcept
+	{
+		if (this->entries.empty()) {
+			return nullptr;
+		}
+
+		auto hash = hash_of(key);
+		for (size_t i = hash & this->mask;; i = (i + 1) & this->mask) {
+			const auto& e = this->entries[i];
+			if (!e.value) {
+				return nullptr;
+			}
+			if (e.hash == hash && e.key == key) {
+				return e.value;
+			}
+		}
+	}
+
+	/**
+	 * @brief Count entries examined when looking up the key.
+	 * Same as find(), but returns the number of probed entries, for statistics.
+	 * @param key - key to look up.
+	 * @return number of entries examined, including the last one, which either matches the key or is empty.
+	 */
+	size_t count_probes(std::string_view key) const noexcept
+	{
+		if (this->entries.empty()) {
+			return 0;
+		}
+
+		size_t num_probes = 0;
+
+		auto hash = hash_of(key);
+		for (size_t i = hash & this->mask;; i = (i + 1) & this->mask) {
+			++num_probes;
+			const auto& e = this->entries[i];
+			if (!e.value || (e.hash == hash && e.key == key)) {
+				return num_probes;
+			}
+		}
+	}
+
+	/**
+	 * @brief Get number of values in the table.
+	 * @return number of values in the table.
+	 */
+	size_t size() const noexcept
+	{
+		return this->num_values;
+	}
+};
+
+} // namespace clargs
@@ -0,0 +1,138 @@
+/*
+MIT License
+
+Copyright (c) 2018-2023 Ivan Gagis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+#include "mapped_file.hpp"
+
+#include <system_error>
+
+#include <utki/config.hpp>
+
+#if CFG_OS == CFG_OS_WINDOWS
+#	include <windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+#include <utki/util.hpp>
+
+using namespace clargs;
+
+#if CFG_OS == CFG_OS_WINDOWS
+
+mapped_file::mapped_file(const std::string& path)
+{
+	HANDLE file = CreateFileA(
+		path.c_str(), //
+		GENERIC_READ,
+		FILE_SHARE_READ,
+		nullptr,
+		OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL,
+		nullptr
+	);
+	if (file == INVALID_HANDLE_VALUE) {
+		throw std::system_error(int(GetLastError()), std::system_category(), "could not open file: " + path);
+	}
+	utki::scope_exit file_scope_exit([file]() {
+		CloseHandle(file);
+	});
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size)) {
+		throw std::system_error(int(GetLastError()), std::system_category(), "could not get file size: " + path);
+	}
+
+	if (size.QuadPart == 0) {
+		// empty files cannot be mapped
+		return;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+	if (!mapping) {
+		throw std::system_error(int(GetLastError()), std::system_category(), "could not map file: " + path);
+	}
+	utki::scope_exit mapping_scope_exit([mapping]() {
+		// the view keeps the mapping object alive
+		CloseHandle(mapping);
+	});
+
+	void* ptr = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+	if (!ptr) {
+		throw std::system_error(int(GetLastError()), std::system_category(), "could not map file: " + path);
+	}
+
+	this->memory = utki::make_span(static_cast<char*>(ptr), size_t(size.QuadPart));
+}
+
+mapped_file::~mapped_file()
+{
+	if (this->memory.data()) {
+		UnmapViewOfFile(this->memory.data());
+	}
+}
+
+#else
+
+mapped_file::mapped_file(const std::string& path)
+{
+	// NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		throw std::system_error(errno, std::generic_category(), "could not open file: " + path);
+	}
+	utki::scope_exit fd_scope_exit([fd]() {
+		close(fd);
+	});
+
+	struct stat st {};
+	if (fstat(fd, &st) != 0) {
+		throw std::system_error(errno, std::generic_category(), "could not get file size: " + path);
+	}
+
+	if (st.st_size == 0) {
+		// empty files cannot be mapped
+		return;
+	}
+
+	void* ptr = mmap(nullptr, size_t(st.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	if (ptr == MAP_FAILED) {
+		throw std::system_error(errno, std::generic_category(), "could not map file: " + path);
+	}
+
+	this->memory = utki::make_span(static_cast<char*>(ptr), size_t(st.st_size));
+}
+
+mapped_file::~mapped_file()
+{
+	if (this->memory.data()) {
+		munmap(this->memory.data(), this->memory.size());
+	}
+}
+
+#endif
@@ -0,0 +1,75 @@
+/*
+MIT License
+
+Copyright (c) 2018-2023 Ivan Gagis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+#pragma once
+
+#include <string>
+
+#include <utki/span.hpp>
+
+namespace clargs {
+
+/**
+ * @brief Private memory mapping of a file.
+ * Maps the whole file to memory in copy-on-write mode, so that the mapped memory can be
+ * modified without affecting the file. Only the modified pages are copied.
+ */
+class mapped_file
+{
+	utki::span<char> memory;
+
+public:
+	/**
+	 * @brief Map file to memory.
+	 * @param path - path to the file.
+	 * @throw std::system_error - in case the file could not be opened or mapped.
+	 */
+	explicit mapped_file(const std::string& path);
+
+	mapped_file(const mapped_file&) = delete;
+	mapped_file& operator=(const mapped_file&) = delete;
+
+	mapped_file(mapped_file&& f) noexcept :
+		memory(f.memory)
+	{
+		f.memory = utki::span<char>();
+	}
+
+	mapped_file& operator=(mapped_file&&) = delete;
+
+	~mapped_file();
+
+	/**
+	 * @brief Get mapped memory.
+	 * @return span of the mapped file contents.
+	 */
+	utki::span<char> data() const noexcept
+	{
+		return this->memory;
+	}
+};
+
+} // namespace clargs
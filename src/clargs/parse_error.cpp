@@ -0,0 +1,134 @@
+/*
+MIT License
+
+Copyright (c) 2018-2023 Ivan Gagis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+#include "parse_error.hpp"
+
+#include <sstream>
+
+using namespace clargs;
+
+namespace {
+std::string exception_message(const std::exception_ptr& exception)
+{
+	if (!exception) {
+		return {};
+	}
+
+	try {
+		std::rethrow_exception(exception);
+	} catch (std::exception& e) {
+		return e.what();
+	} catch (...) {
+		return "unknown exception";
+	}
+}
+} // namespace
+
+std::string parse_error::message() const
+{
+	std::stringstream ss;
+
+	// MSVC: no operator<<(std::string_view), so all the views are converted to std::string
+	if (this->line != 0) {
+		ss << std::string(this->file) << ":" << this->line << ": ";
+	}
+
+	switch (this->code) {
+		case error_code::none:
+			break;
+		case error_code::unknown_argument:
+			ss << "unknown argument: " << std::string(this->argument);
+			if (this->suggestions.size() == 1) {
+				ss << ", did you mean --" << this->suggestions.front() << "?";
+			} else if (!this->suggestions.empty()) {
+				ss << ", did you mean one of ";
+				for (auto i = this->suggestions.begin(); i != this->suggestions.end(); ++i) {
+					if (i != this->suggestions.begin()) {
+						ss << ", ";
+					}
+					ss << "--" << *i;
+				}
+				ss << "?";
+			}
+			break;
+		case error_code::ambiguous_argument:
+			ss << "ambiguous argument: " << std::string(this->argument) << ", possible keys: ";
+			for (auto i = this->candidates.begin(); i != this->candidates.end(); ++i) {
+				if (i != this->candidates.begin()) {
+					ss << ", ";
+				}
+				ss << "--" << *i;
+			}
+			break;
+		case error_code::unexpected_value:
+			ss << "key argument '" << std::string(this->key) << "' is a boolean argument and cannot have value";
+			break;
+		case error_code::missing_value:
+			if (this->argument.substr(0, 2) == "--") {
+				ss << "key argument '" << std::string(this->key) << "' requires value";
+			} else {
+				ss << "argument '" << std::string(this->key) << "' requires value";
+			}
+			break;
+		case error_code::invalid_value:
+			ss << "invalid value of argument '" << std::string(this->key) << "': " << std::string(this->value);
+			break;
+		case error_code::value_out_of_range:
+			ss << "value of argument '" << std::string(this->key) << "' is out of range: "
+			   << std::string(this->value);
+			break;
+		case error_code::unknown_subcommand:
+			ss << "unknown subcommand: " << std::string(this->argument);
+			break;
+		case error_code::response_file_unreadable:
+			ss << "could not read response file '" << std::string(this->argument.substr(1))
+			   << "': " << exception_message(this->exception);
+			break;
+		case error_code::response_files_too_deep:
+			ss << "response files nesting is too deep";
+			break;
+		case error_code::unterminated_quote:
+			ss << "unterminated quote in command line";
+			break;
+		case error_code::config_file_unreadable:
+			ss << "could not read config file '" << std::string(this->file)
+			   << "': " << exception_message(this->exception);
+			break;
+		case error_code::non_key_argument_not_viewable:
+			ss << "parse_views(): non-key argument read from response file cannot be returned as a view";
+			break;
+		case error_code::value_not_viewable:
+			ss << "value of argument '" << std::string(this->key)
+			   << "' is only valid during parsing and cannot be collected as a view";
+			break;
+		case error_code::exception_thrown:
+			ss << "exception thrown while parsing argument " << std::string(this->argument) << ": "
+			   << exception_message(this->exception);
+			break;
+	}
+
+	return ss.str();
+}
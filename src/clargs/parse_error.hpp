@@ -0,0 +1,214 @@
+/*
+MIT License
+
+Copyright (c) 2018-2023 Ivan Gagis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace clargs {
+
+/**
+ * @brief Kind of command line parsing error.
+ */
+enum class error_code {
+	/**
+	 * @brief No error.
+	 */
+	none,
+
+	/**
+	 * @brief Argument is not a registered key.
+	 */
+	unknown_argument,
+
+	/**
+	 * @brief Argument is a prefix of several long keys, in case the long key abbreviations are enabled.
+	 */
+	ambiguous_argument,
+
+	/**
+	 * @brief Value is given to a boolean argument.
+	 */
+	unexpected_value,
+
+	/**
+	 * @brief Argument requires value, but none is given.
+	 */
+	missing_value,
+
+	/**
+	 * @brief Value cannot be converted to the type of the bound variable.
+	 */
+	invalid_value,
+
+	/**
+	 * @brief Value is out of range of the type of the bound variable.
+	 */
+	value_out_of_range,
+
+	/**
+	 * @brief First non-key argument is not a registered subcommand.
+	 */
+	unknown_subcommand,
+
+	/**
+	 * @brief Response file cannot be opened or read.
+	 */
+	response_file_unreadable,
+
+	/**
+	 * @brief Response files nesting is too deep.
+	 */
+	response_files_too_deep,
+
+	/**
+	 * @brief Unterminated quote in a response file.
+	 */
+	unterminated_quote,
+
+	/**
+	 * @brief Config file exists, but cannot be read.
+	 */
+	config_file_unreadable,
+
+	/**
+	 * @brief Non-key argument read from a response file cannot be returned as a view.
+	 */
+	non_key_argument_not_viewable,
+
+	/**
+	 * @brief Value read from a response file, a command line string or a stream cannot be collected as a view,
+	 * see parser::add(char, string_arg, string_arg, std::vector<value_type>&).
+	 */
+	value_not_viewable,
+
+	/**
+	 * @brief Exception was thrown by an argument handler.
+	 * The exception is stored in parse_error::exception.
+	 */
+	exception_thrown
+};
+
+/**
+ * @brief Description of a command line parsing error.
+ * Contains only the data needed to locate the error, the human-readable message
+ * is only formatted when message() is called.
+ */
+struct parse_error {
+	/**
+	 * @brief Kind of the error.
+	 */
+	error_code code = error_code::none;
+
+	/**
+	 * @brief Index of the offending argument in the parsed arguments array.
+	 * For errors in response files it is the index of the '@path' argument.
+	 */
+	size_t argument_index = 0;
+
+	/**
+	 * @brief Character offset of the error within the offending argument.
+	 */
+	size_t offset = 0;
+
+	/**
+	 * @brief The offending argument.
+	 */
+	std::string_view argument;
+
+	/**
+	 * @brief Key of the argument the error relates to, if any.
+	 */
+	std::string_view key;
+
+	/**
+	 * @brief Offending value, if any.
+	 */
+	std::string_view value;
+
+	/**
+	 * @brief Long keys the ambiguous argument is a prefix of.
+	 * Set for error_code::ambiguous_argument.
+	 */
+	std::vector<std::string> candidates;
+
+	/**
+	 * @brief Long keys similar to the unknown argument.
+	 * Set for error_code::unknown_argument by the parse functions which throw the errors, in case there are
+	 * registered long keys within small edit distance from the unknown one, see parser::suggest().
+	 * Only the closest keys are given, in alphabetical order.
+	 */
+	std::vector<std::string> suggestions;
+
+	/**
+	 * @brief Path of the config file the offending argument is read from, if any.
+	 * In that case the argument is the line of the config file.
+	 */
+	std::string_view file;
+
+	/**
+	 * @brief Number of the offending line in the config file, starting from 1.
+	 * 0 in case the argument is not read from a config file.
+	 */
+	size_t line = 0;
+
+	/**
+	 * @brief Exception which caused the error, if any.
+	 * Set for error_code::exception_thrown, error_code::response_file_unreadable
+	 * and error_code::config_file_unreadable.
+	 */
+	std::exception_ptr exception;
+
+	/**
+	 * @brief Storage keeping the argument views valid.
+	 * In case the offending argument is read from a response file or a config file, the file
+	 * is kept mapped as long as the parse_error object (or its copy) is alive.
+	 */
+	std::shared_ptr<const void> storage;
+
+	/**
+	 * @brief Check if there is an error.
+	 * @return true if the error code is other than error_code::none.
+	 * @return false otherwise.
+	 */
+	explicit operator bool() const noexcept
+	{
+		return this->code != error_code::none;
+	}
+
+	/**
+	 * @brief Format human-readable error message.
+	 * @return error message.
+	 */
+	std::string message() const;
+};
+
+} // namespace clargs
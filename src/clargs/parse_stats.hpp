@@ -0,0 +1,106 @@
+/*
+MIT License
+
+Copyright (c) 2018-2023 Ivan Gagis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace clargs {
+
+/**
+ * @brief Statistics of a parse() call.
+ * See parser::parse(utki::span<std::string_view>, parse_stats&).
+ */
+struct parse_stats {
+	/**
+	 * @brief Statistics of a handler.
+	 */
+	struct handler_stats {
+		/**
+		 * @brief Number of the handler calls.
+		 */
+		size_t num_calls = 0;
+
+		/**
+		 * @brief Cumulative time spent in the handler.
+		 */
+		std::chrono::nanoseconds time{0};
+	};
+
+	/**
+	 * @brief Total duration of the parse() call.
+	 */
+	std::chrono::nanoseconds time{0};
+
+	/**
+	 * @brief Number of arguments read from the parsed arguments array.
+	 * Arguments read from response files are not counted.
+	 */
+	size_t num_arguments = 0;
+
+	/**
+	 * @brief Number of long key arguments.
+	 */
+	size_t num_long_keys = 0;
+
+	/**
+	 * @brief Number of short key arguments, including each key of short keys batches.
+	 */
+	size_t num_short_keys = 0;
+
+	/**
+	 * @brief Number of non-key arguments, not counting the subcommand.
+	 */
+	size_t num_non_keys = 0;
+
+	/**
+	 * @brief Number of entries examined in the long keys lookup tables.
+	 * Short keys are looked up by direct indexing, so they do not need probing.
+	 */
+	size_t num_probes = 0;
+
+	/**
+	 * @brief Statistics of the key argument handlers, indexed by argument id.
+	 * Storing values to the bound variables is counted as a handler call as well.
+	 */
+	std::vector<handler_stats> arguments;
+
+	/**
+	 * @brief Statistics of handling non-key arguments.
+	 * Either the non-key arguments handler calls or storing the non-key arguments to the returned vector.
+	 */
+	handler_stats non_key;
+
+	/**
+	 * @brief Statistics of handling the subcommand.
+	 * Includes setting up the sub-parser and parsing the subcommand's arguments, which are not counted separately.
+	 */
+	handler_stats subcommand;
+};
+
+} // namespace clargs
@@ -26,168 +26,436 @@ SOFTWARE.
 
 #include "parser.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <optional>
 #include <sstream>
+#include <system_error>
+
+#include <utki/config.hpp>
+
+#if CFG_OS == CFG_OS_MACOSX
+#	include <crt_externs.h>
+#elif CFG_OS != CFG_OS_WINDOWS
+// not declared by all the system headers
+extern char** environ; // NOLINT
+#endif
+
+#include "edit_distance.hpp"
+#include "mapped_file.hpp"
+#include "static_parser.hpp"
+#include "stream_reader.hpp"
+#include "tokenizer.hpp"
 
-#include <utki/string.hpp>
 #include <utki/util.hpp>
 
 using namespace clargs;
 
-void parser::push_back_description(
-	char short_key, //
-	const std::string& long_key,
-	std::string description,
-	bool is_boolean,
-	bool is_value_optional
-)
+void parser::key_description::append_key_names(std::string& out) const
 {
-	std::stringstream ss;
-	ss << "  ";
+	out.append("  ");
 
-	if (short_key != '\0') {
-		ss << '-' << short_key;
-		if (!is_boolean && long_key.empty()) {
-			ss << " VALUE";
+	if (this->short_key != '\0') {
+		out.push_back('-');
+		out.push_back(this->short_key);
+		if (!this->is_boolean && this->long_key.empty()) {
+			out.append(" VALUE");
 		}
 	}
 
-	if (!long_key.empty()) {
-		if (short_key != '\0') {
-			ss << ", ";
+	if (!this->long_key.empty()) {
+		if (this->short_key != '\0') {
+			out.append(", ");
 		} else {
-			ss << "    ";
+			out.append("    ");
 		}
 
-		ss << "--" << long_key;
-		if (!is_boolean) {
-			if (is_value_optional) {
-				ss << "[=VALUE]";
+		out.append("--").append(this->long_key);
+		if (!this->is_boolean) {
+			if (this->is_value_optional) {
+				out.append("[=VALUE]");
 			} else {
-				ss << "=VALUE";
+				out.append("=VALUE");
 			}
 		}
 	}
+}
+
+size_t parser::add(
+	char short_key, //
+	string_arg long_key,
+	string_arg description,
+	value_kind value
+)
+{
+	argument_handlers handlers;
+
+	switch (value) {
+		case value_kind::none:
+			handlers.boolean_handler = []() {};
+			break;
+		case value_kind::optional:
+			handlers.boolean_handler = []() {};
+			[[fallthrough]];
+		case value_kind::required:
+			handlers.value_handler = [](std::string_view) {};
+			break;
+	}
 
-	this->key_descriptions.push_back({ss.str(), std::move(description)});
+	return this->add_argument(
+		short_key, //
+		long_key,
+		description,
+		std::move(handlers)
+	);
 }
 
-void parser::add_argument(
+size_t parser::add_argument(
 	char short_key, //
-	std::string long_key,
-	std::string description,
-	std::function<void(std::string_view)> value_handler,
-	std::function<void()> boolean_handler
+	string_arg long_key,
+	string_arg description,
+	argument_handlers handlers
 )
 {
-	bool is_boolean = !value_handler && boolean_handler;
+	this->throw_if_frozen();
 
-	this->push_back_description(short_key, long_key, std::move(description), is_boolean, boolean_handler != nullptr);
-	utki::scope_exit description_scope_exit([this]() {
-		this->key_descriptions.pop_back();
-	});
+	bool is_boolean = !handlers.value_handler && !handlers.binding;
+	bool is_value_optional = handlers.boolean_handler || handlers.binding.implicit_value;
 
-	auto actual_key = this->get_long_key_for_short_key(short_key, std::move(long_key));
+	// the long key is empty for short-only keys, except the '--' argument which has empty long key and no short key
+	bool has_long_key = !long_key.view().empty() || short_key == '\0';
 
-	if (this->arguments.find(actual_key) != this->arguments.end()) {
+	if (has_long_key && this->arguments_table.find(long_key.view())) {
 		std::stringstream ss;
-		ss << "argument with ";
-		ASSERT(!actual_key.empty())
-		if (actual_key.front() == ' ') {
-			ASSERT(actual_key.size() == 2)
-			ss << "short key '" << actual_key[1] << "'";
-		} else {
-			ss << "long key '" << actual_key << "'";
-		}
-		ss << " already exists";
+		ss << "argument with long key '" << long_key.view() << "' already exists";
 		throw std::logic_error(ss.str());
 	}
 
-	auto res = this->arguments.insert(
-		// NOLINTNEXTLINE(modernize-use-designated-initializers, "needs C++20, while we use C++17")
-		std::make_pair(std::move(actual_key), argument_callbacks{std::move(value_handler), std::move(boolean_handler)})
-	);
-	ASSERT(res.second)
+	if (short_key != '\0' && this->short_key_arguments[static_cast<unsigned char>(short_key)]) {
+		std::stringstream ss;
+		ss << "argument with short key '" << short_key << "' already exists";
+		throw std::logic_error(ss.str());
+	}
+
+	auto key = this->store(long_key);
+
+	auto callbacks = this->storage.make<argument_callbacks>();
+	callbacks->binding = handlers.binding;
+	callbacks->id = this->arguments.size();
+
+	if (handlers.value_handler) {
+		callbacks->handler = std::move(handlers.value_handler);
+		if (handlers.boolean_handler) {
+			callbacks->default_handler = this->storage.make<boolean_handler_type>(std::move(handlers.boolean_handler));
+		}
+	} else if (handlers.boolean_handler) {
+		callbacks->handler = std::move(handlers.boolean_handler);
+	}
+
+	this->arguments.push_back(std::move(callbacks));
+
+	utki::scope_exit argument_scope_exit([this] {
+		this->arguments.pop_back();
+	});
 
-	utki::scope_exit argument_scope_exit([&res, this] {
-		this->arguments.erase(res.first);
+	this->key_descriptions.push_back({
+		short_key, //
+		key,
+		this->store(description),
+		is_boolean,
+		is_value_optional
 	});
 
-	// add short to long key mapping if there is a short key
+	utki::scope_exit description_scope_exit([this] {
+		this->key_descriptions.pop_back();
+	});
+
+	auto& argument = *this->arguments.back();
+
+	if (has_long_key) {
+		this->arguments_table.insert(key, argument);
+	}
+
 	if (short_key != '\0') {
-		auto i = this->short_to_long_map.insert(std::make_pair(short_key, std::string_view(res.first->first)));
-		if (!i.second) {
-			std::stringstream ss;
-			ss << "argument with short key '" << short_key << "' already exists";
-			throw std::logic_error(ss.str());
-		}
+		this->short_key_arguments[static_cast<unsigned char>(short_key)] = &argument;
 	}
 
-	argument_scope_exit.release();
 	description_scope_exit.release();
+	argument_scope_exit.release();
+
+	std::atomic_store(&this->cached_description, std::shared_ptr<const description_cache>());
+	std::atomic_store(&this->cached_key_trie, std::shared_ptr<const key_trie<const argument_callbacks>>());
+
+	return argument.id;
 }
 
-std::string parser::get_long_key_for_short_key(
+size_t parser::add_collecting_argument(
 	char short_key, //
-	std::string&& long_key
+	string_arg long_key,
+	string_arg description,
+	value_binding binding,
+	void (*reserve)(void* values, size_t num_values)
 )
 {
-	if (long_key.empty() && short_key != '\0') {
-		// key name cannot have spaces, so starting a long name with space makes
-		// sure it will not clash with another long name of one letter
-		std::stringstream ss;
-		ss << ' ' << short_key;
-		return ss.str();
+	this->collectors.push_back({nullptr, reserve});
+
+	utki::scope_exit collector_scope_exit([this] {
+		this->collectors.pop_back();
+	});
+
+	auto id = this->add_argument(
+		short_key, //
+		long_key,
+		description,
+		{nullptr, nullptr, binding}
+	);
+
+	collector_scope_exit.release();
+
+	auto& argument = *this->arguments[id];
+	argument.collector_index = this->collectors.size() - 1;
+	this->collectors.back().argument = &argument;
+
+	return id;
+}
+
+const parser::argument_callbacks* parser::find_argument(std::string_view key) const
+{
+	auto a = this->arguments_table.find(key);
+	if (!a && this->parent) {
+		return this->parent->find_argument(key);
+	}
+	return a;
+}
+
+namespace {
+// maximum edit distance of the suggested keys from the unknown one
+constexpr size_t max_suggestion_distance = 3;
+
+constexpr size_t max_num_suggestions = 5;
+} // namespace
+
+std::vector<std::string> parser::suggest(std::string_view key) const
+{
+	if (key.empty() || key.size() > edit_distance_matcher::max_pattern_length) {
+		return {};
+	}
+
+	// the allowed distance grows with the key length, so that short keys are not similar to everything
+	auto max_distance = std::min(max_suggestion_distance, std::max(size_t(1), (key.size() + 1) / 3));
+
+	edit_distance_matcher matcher(key);
+
+	auto best_distance = max_distance;
+	std::vector<std::string_view> best_keys;
+
+	// columns of the prefixes of the previously compared key, the keys are compared in sorted order,
+	// so that the common prefix of the consecutive keys is only processed once
+	std::vector<edit_distance_matcher::column> columns;
+
+	for (auto p = this; p; p = p->parent) {
+		auto trie = p->get_key_trie();
+
+		columns.assign(1, matcher.first_column());
+
+		auto entries = trie->get_entries();
+		for (size_t index = 0; index != entries.size(); ++index) {
+			const auto& e = entries[index];
+			auto k = e.key;
+
+			// keep the columns of the prefix common with the previous key, also for the skipped keys,
+			// so that the columns are always of a prefix of the current key
+			columns.resize(std::min(columns.size(), trie->get_common_prefix_length(index) + 1));
+
+			// each edit changes the length by at most one
+			if ((k.size() > key.size() ? k.size() - key.size() : key.size() - k.size()) > best_distance) {
+				continue;
+			}
+
+			for (auto i = columns.size() - 1; i != k.size(); ++i) {
+				columns.push_back(matcher.next_column(columns.back(), k[i]));
+
+				// the distance decreases at most by one per each remaining character
+				if (columns.back().distance > best_distance + (k.size() - i - 1)) {
+					break;
+				}
+			}
+
+			if (columns.size() != k.size() + 1 || columns.back().distance > best_distance) {
+				continue;
+			}
+
+			// keys of the parent parsers can be shadowed by the same keys of the sub-parsers
+			if (p != this && this->find_argument(k) != e.value) {
+				continue;
+			}
+
+			if (columns.back().distance < best_distance) {
+				best_distance = columns.back().distance;
+				best_keys.clear();
+			}
+			best_keys.push_back(k);
+		}
 	}
 
-	return std::move(long_key);
+	// all the found keys are equally close, so they are suggested in alphabetical order
+	std::sort(best_keys.begin(), best_keys.end());
+	if (best_keys.size() > max_num_suggestions) {
+		best_keys.resize(max_num_suggestions);
+	}
+
+	return {best_keys.begin(), best_keys.end()};
 }
 
-std::string parser::description(
+std::shared_ptr<const key_trie<const parser::argument_callbacks>> parser::get_key_trie() const
+{
+	auto trie = std::atomic_load(&this->cached_key_trie);
+	if (trie) {
+		return trie;
+	}
+
+	std::vector<key_trie<const argument_callbacks>::entry> entries;
+	entries.reserve(this->arguments_table.size());
+
+	ASSERT(this->key_descriptions.size() == this->arguments.size())
+	for (size_t i = 0; i != this->arguments.size(); ++i) {
+		auto key = this->key_descriptions[i].long_key;
+		if (!key.empty()) {
+			entries.push_back({key, this->arguments[i].get()});
+		}
+	}
+
+	trie = std::make_shared<key_trie<const argument_callbacks>>(std::move(entries));
+
+	std::atomic_store(&this->cached_key_trie, trie);
+
+	return trie;
+}
+
+const parser::argument_callbacks* parser::find_abbreviated_argument(
+	std::string_view prefix, //
+	std::vector<std::string>& candidates
+) const
+{
+	const argument_callbacks* found = nullptr;
+	size_t num_found = 0;
+
+	for (auto p = this; p; p = p->parent) {
+		auto trie = p->get_key_trie();
+		for (const auto& e : trie->find_prefix(prefix)) {
+			// keys of the parent parsers can be shadowed by the same keys of the sub-parsers
+			if (p != this && this->find_argument(e.key) != e.value) {
+				continue;
+			}
+			found = e.value;
+			++num_found;
+		}
+	}
+
+	if (num_found == 1) {
+		return found;
+	}
+
+	if (num_found > 1) {
+		for (auto p = this; p; p = p->parent) {
+			auto trie = p->get_key_trie();
+			for (const auto& e : trie->find_prefix(prefix)) {
+				if (p != this && this->find_argument(e.key) != e.value) {
+					continue;
+				}
+				candidates.emplace_back(e.key);
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+namespace {
+struct string_sink {
+	std::string& text;
+
+	void put(char c)
+	{
+		this->text.push_back(c);
+	}
+};
+} // namespace
+
+std::shared_ptr<const parser::description_cache> parser::get_description(
 	unsigned keys_width, //
 	unsigned width
 ) const
 {
-	std::stringstream ss;
+	auto cache = std::atomic_load(&this->cached_description);
+	if (cache && cache->keys_width == keys_width && cache->width == width) {
+		return cache;
+	}
+
+	auto c = std::make_shared<description_cache>();
+	c->keys_width = keys_width;
+	c->width = width;
+
+	auto& text = c->text;
 
-	auto indentation = std::string(keys_width + 2, ' ');
 	for (auto& d : this->key_descriptions) {
-		ss << d.key_names;
+		auto key_names_begin = text.size();
+		d.append_key_names(text);
+		auto key_names_size = text.size() - key_names_begin;
 
-		if (d.key_names.size() > keys_width) {
-			ss << std::endl << indentation;
+		if (key_names_size > keys_width) {
+			text.push_back('\n');
+			text.append(keys_width + 2, ' ');
 		} else {
-			ss << std::string(keys_width - d.key_names.size(), ' ') << "  ";
+			text.append(keys_width - key_names_size + 2, ' ');
 		}
 
-		auto lines = utki::word_wrap(d.description, width);
+		// same wrapping as of the compile time description, see make_description()
+		string_sink sink{text};
+		internal::write_wrapped(sink, d.description, width, keys_width + 2);
+	}
 
-		ASSERT(lines.size() >= 1)
+	std::atomic_store(&this->cached_description, std::shared_ptr<const description_cache>(c));
 
-		ss << lines.front() << std::endl;
+	return c;
+}
 
-		for (auto i = std::next(lines.begin()); i != lines.end(); ++i) {
-			ss << indentation << (*i) << std::endl;
-		}
-	}
+std::string parser::description(
+	unsigned keys_width, //
+	unsigned width
+) const
+{
+	return this->get_description(keys_width, width)->text;
+}
 
-	return ss.str();
+void parser::write_description(
+	std::ostream& out, //
+	unsigned keys_width,
+	unsigned width
+) const
+{
+	auto d = this->get_description(keys_width, width);
+	out.write(d->text.data(), std::streamsize(d->text.size()));
 }
 
 namespace {
-const std::string long_key_prefix = "--";
+constexpr std::string_view long_key_prefix = "--";
 const unsigned short_key_argument_size = 2;
 } // namespace
 
 std::vector<std::string> parser::parse(
 	int argc, //
 	const char* const* argv
-)
+) const
 {
 	ASSERT(argc >= 1)
 	return this->parse(utki::make_span(argv, argc).subspan(1));
 }
 
-std::vector<std::string> parser::parse(utki::span<const char* const> args)
+std::vector<std::string> parser::parse(utki::span<const char* const> args) const
 {
 	std::vector<std::string_view> sv_args;
 	sv_args.reserve(args.size());
@@ -199,145 +467,1298 @@ std::vector<std::string> parser::parse(utki::span<const char* const> args)
 	return this->parse(sv_args);
 }
 
-std::vector<std::string> parser::parse(utki::span<std::string_view> args)
+thread_local parser::parse_context* parser::innermost_parse_context = nullptr;
+
+namespace {
+// limit of response files nesting, to detect response files referring to themselves
+constexpr size_t max_response_files_depth = 64;
+
+void throw_parse_error(const parse_error& error)
 {
-	std::vector<std::string> ret;
+	switch (error.code) {
+		case error_code::none:
+			return;
+		case error_code::response_file_unreadable:
+		case error_code::config_file_unreadable:
+		case error_code::exception_thrown:
+			ASSERT(error.exception)
+			std::rethrow_exception(error.exception);
+		case error_code::non_key_argument_not_viewable:
+		case error_code::value_not_viewable:
+			throw std::logic_error(error.message());
+		default:
+			throw std::invalid_argument(error.message());
+	}
+}
+} // namespace
 
-	for (auto i = args.begin(); i != args.end() && !this->stop_parsing_requested; ++i) {
-		std::string arg(*i);
+struct parser::token_range::response_files_state {
+	std::vector<mapped_file> files;
 
-		if (this->is_key_parsing_enabled && arg.size() >= long_key_prefix.size() && arg.find(long_key_prefix) == 0) {
-			this->parse_long_key_argument(arg);
-		} else if (this->is_key_parsing_enabled && arg.size() >= short_key_argument_size && arg[0] == '-') {
-			auto h = this->parse_short_keys_batch(arg);
-
-			if (h) {
-				// value is the next argument
-				++i;
-				if (i == args.end()) {
-					std::stringstream ss;
-					ss << "argument '" << arg.back() << "' requires value";
-					throw std::invalid_argument(ss.str());
-				}
-				(*h)(*i);
+	// tokenizers of the response files being read, the last one is of the innermost response file
+	std::vector<tokenizer> stack;
+
+	// remaining arguments read from response files and from the args or the command line, see remaining()
+	std::vector<std::string_view> remaining;
+
+	// storage of the remaining arguments read from the stream
+	std::vector<std::string> remaining_strings;
+
+	// number of the leading remaining arguments which are read from response files
+	size_t num_remaining_from_response_files = 0;
+};
+
+parser::token_range::token_range(
+	const parser& owner, //
+	utki::span<std::string_view> args
+) :
+	owner(owner),
+	args(args),
+	is_key_parsing_enabled(owner.is_key_parsing_enabled_initially)
+{}
+
+parser::token_range::~token_range() = default;
+
+parser::token_range parser::tokens(utki::span<std::string_view> args) const
+{
+	return token_range(*this, args);
+}
+
+void parser::token_range::fail(
+	error_code code, //
+	std::string_view argument,
+	size_t offset,
+	std::string_view key,
+	std::string_view value
+)
+{
+	ASSERT(!this->error_info)
+
+	this->is_finished = true;
+
+	auto& e = this->error_info;
+
+	e.code = code;
+
+	// the arguments read from response files do not advance the index,
+	// so it is always the index of the args item last read
+	e.argument_index = this->index == 0 ? 0 : this->index - 1;
+	e.offset = offset;
+	e.argument = argument;
+	e.key = key;
+	e.value = value;
+
+	if (this->response_files) {
+		// the views may point into the response files
+		e.storage = std::move(this->response_files);
+	}
+}
+
+void parser::token_range::check(
+	conversion_result result, //
+	std::string_view value
+)
+{
+	switch (result) {
+		case conversion_result::ok:
+			return;
+		case conversion_result::out_of_range:
+			this->fail(
+				error_code::value_out_of_range, //
+				this->current_arg,
+				this->current_value_offset,
+				this->current_key,
+				value
+			);
+			return;
+		case conversion_result::invalid_value:
+			break;
+	}
+	this->fail(
+		error_code::invalid_value, //
+		this->current_arg,
+		this->current_value_offset,
+		this->current_key,
+		value
+	);
+}
+
+bool parser::token_range::is_reading_response_file() const noexcept
+{
+	return this->response_files && !this->response_files->stack.empty();
+}
+
+bool parser::token_range::read(std::string_view& arg)
+{
+	if (this->response_files) {
+		auto& stack = this->response_files->stack;
+		while (!stack.empty()) {
+			switch (stack.back().next(arg)) {
+				case tokenizer::status::ok:
+					return true;
+				case tokenizer::status::end:
+					stack.pop_back();
+					break;
+				case tokenizer::status::unterminated_quote:
+					this->fail(error_code::unterminated_quote, this->last_arg, 0);
+					return false;
 			}
+		}
+	}
+
+	if (this->command_line) {
+		switch (this->command_line->next(arg)) {
+			case tokenizer::status::ok:
+				break;
+			case tokenizer::status::end:
+				return false;
+			case tokenizer::status::unterminated_quote:
+				++this->index;
+				this->fail(error_code::unterminated_quote, arg, 0);
+				return false;
+		}
+	} else if (this->stream) {
+		if (!this->stream->next(arg)) {
+			return false;
+		}
+	} else if (this->is_nul_separated) {
+		auto& buf = this->nul_separated_args;
+		if (buf.empty()) {
+			return false;
+		}
+		auto nul = static_cast<const char*>(std::memchr(buf.data(), '\0', buf.size()));
+		if (nul) {
+			arg = buf.substr(0, nul - buf.data());
+			buf.remove_prefix(arg.size() + 1);
 		} else {
-			if (this->is_key_parsing_enabled && this->subcommand_handler) {
-				auto cmd_index = std::distance(args.begin(), i);
-				ASSERT(cmd_index >= 0)
-				ASSERT(size_t(cmd_index) < args.size())
-				++cmd_index;
-				this->subcommand_handler( //
-					std::string_view(*i),
-					args.subspan(cmd_index)
-				);
-				ASSERT(ret.empty())
-				return ret;
-			} else {
-				if (this->non_key_handler) {
-					this->non_key_handler(std::move(arg));
-				} else {
-					ret.push_back(std::move(arg));
-				}
-			}
+			// last argument is not terminated
+			arg = buf;
+			buf = std::string_view();
+		}
+	} else {
+		if (this->index == this->args.size()) {
+			return false;
 		}
+		arg = this->args[this->index];
 	}
 
-	return ret;
+	++this->index;
+	this->last_arg = arg;
+	return true;
 }
 
-void parser::parse_long_key_argument(std::string_view arg)
+void parser::token_range::push_response_file(std::string_view arg)
 {
-	auto equals_pos = arg.find("=");
-	if (equals_pos != std::string::npos) {
-		auto value = arg.substr(equals_pos + 1);
-		auto key = arg.substr(long_key_prefix.size(), equals_pos - long_key_prefix.size());
-
-		auto i = this->arguments.find(key);
-		if (i != this->arguments.end()) {
-			if (!i->second.value_handler) {
-				std::stringstream ss;
-				ss << "key argument '" << std::string(key); // MSVC: no operator<<(std::string_view)
-				ss << "' is a boolean argument and cannot have value";
-				throw std::invalid_argument(ss.str());
-			}
-			i->second.value_handler(std::move(value));
-			return;
+	if (!this->response_files) {
+		this->response_files = std::make_unique<response_files_state>();
+	}
+
+	auto& rf = *this->response_files;
+
+	if (rf.stack.size() == max_response_files_depth) {
+		this->fail(error_code::response_files_too_deep, this->last_arg, 0);
+		return;
+	}
+
+	try {
+		rf.files.emplace_back(std::string(arg.substr(1)));
+	} catch (std::system_error&) {
+		this->fail(error_code::response_file_unreadable, arg, 1);
+		this->error_info.exception = std::current_exception();
+		return;
+	}
+	rf.stack.emplace_back(rf.files.back().data());
+}
+
+utki::span<std::string_view> parser::token_range::remaining()
+{
+	this->is_finished = true;
+	this->has_current = false;
+
+	if (!this->command_line && !this->is_nul_separated && !this->stream && !this->is_reading_response_file()) {
+		auto ret = this->args.subspan(this->index);
+		this->index = this->args.size();
+		return ret;
+	}
+
+	if (!this->response_files) {
+		this->response_files = std::make_unique<response_files_state>();
+	}
+
+	auto& ret = this->response_files->remaining;
+
+	std::string_view arg;
+	if (this->stream) {
+		// the arguments read from the stream are only valid until the next one is read
+		auto& strings = this->response_files->remaining_strings;
+		while (this->read(arg)) {
+			strings.emplace_back(arg);
 		}
+		ret.assign(strings.begin(), strings.end());
 	} else {
-		auto key = arg.substr(long_key_prefix.size());
-		auto i = this->arguments.find(key);
-		if (i != this->arguments.end()) {
-			ASSERT(i->second.boolean_handler)
-			i->second.boolean_handler();
-			return;
-		} else if (arg.size() == 2) {
-			ASSERT(arg == "--")
-			// default handling of '--' argument is disabling key arguments parsing
-			this->set_key_parsing(false);
-			return;
+		while (this->read(arg)) {
+			ret.push_back(arg);
+			if (this->is_reading_response_file()) {
+				++this->response_files->num_remaining_from_response_files;
+			}
 		}
 	}
-	std::stringstream ss;
-	ss << "unknown argument: " << std::string(arg); // MSVC: no operator<<(std::string_view)
-	throw std::invalid_argument(ss.str());
+
+	if (this->error_info) {
+		return {};
+	}
+
+	return ret;
 }
 
-std::function<void(std::string_view)>* parser::parse_short_keys_batch(std::string_view arg)
+bool parser::token_range::next(token& t)
 {
-	ASSERT(arg.size() > 1)
-	for (unsigned i = 1; i != arg.size(); ++i) {
-		auto key = arg[i];
+	this->is_started = true;
+
+	if (this->is_finished) {
+		return false;
+	}
+
+	if (!this->batch.empty()) {
+		return this->read_batch_key(t);
+	}
 
-		std::array<char, 2> no_long_key_actual_key = {' '};
-		std::string_view actual_key;
+	std::string_view arg;
+	while (this->read(arg)) {
+		if (this->is_key_parsing_enabled && this->owner.is_response_files_expansion_enabled && arg.size() > 1 &&
+			arg.front() == '@')
 		{
-			auto iter = this->short_to_long_map.find(key);
-			if (iter != this->short_to_long_map.end()) {
-				actual_key = iter->second;
+			this->push_response_file(arg);
+			if (this->error_info) {
+				return false;
+			}
+		} else if (this->is_key_parsing_enabled && arg.substr(0, long_key_prefix.size()) == long_key_prefix) {
+			if (this->read_long_key(arg, t)) {
+				return true;
+			}
+			if (this->error_info) {
+				return false;
+			}
+		} else if (this->is_key_parsing_enabled && arg.size() >= short_key_argument_size && arg[0] == '-') {
+			this->batch = arg;
+			this->batch_pos = 1;
+			return this->read_batch_key(t);
+		} else {
+			if (this->is_key_parsing_enabled && this->owner.has_subcommands()) {
+				t.kind = token_kind::subcommand;
+				// no more tokens after the subcommand, the rest of the arguments are available via remaining()
+				this->is_finished = true;
+				if (this->stream && !this->is_reading_response_file()) {
+					// reading the remaining arguments from the stream can overwrite the subcommand
+					arg = this->stream->pin(arg);
+				}
 			} else {
-				no_long_key_actual_key[1] = key; // make key name starting with space
-				actual_key = std::string_view(no_long_key_actual_key.data(), no_long_key_actual_key.size());
+				t.kind = token_kind::non_key;
 			}
+			t.id = npos;
+			t.has_value = true;
+			t.value = arg;
+			this->current_argument = nullptr;
+			return true;
 		}
+	}
+
+	this->is_finished = true;
+	return false;
+}
+
+bool parser::token_range::read_long_key(
+	std::string_view arg, //
+	token& t
+)
+{
+	auto equals_pos = arg.find("=");
+	auto key = equals_pos == std::string::npos
+		? arg.substr(long_key_prefix.size())
+		: arg.substr(long_key_prefix.size(), equals_pos - long_key_prefix.size());
 
-		auto iter = this->arguments.find(actual_key);
-		if (iter == this->arguments.end()) {
-			std::stringstream ss;
-			ss << "unknown argument: " << std::string(arg); // MSVC: no operator<<(std::string_view)
-			throw std::invalid_argument(ss.str());
+	auto a = this->owner.find_argument(key);
+	if (!a && this->owner.are_key_abbreviations_enabled && !key.empty()) {
+		std::vector<std::string> candidates;
+		a = this->owner.find_abbreviated_argument(key, candidates);
+		if (!candidates.empty()) {
+			this->fail(error_code::ambiguous_argument, arg, long_key_prefix.size(), key);
+			this->error_info.candidates = std::move(candidates);
+			return false;
 		}
+	}
 
-		auto& h = iter->second;
+	if (equals_pos != std::string::npos) {
+		auto value = arg.substr(equals_pos + 1);
 
-		if (!h.boolean_handler) {
-			ASSERT(h.value_handler)
-			++i;
-			if (i == arg.size()) {
-				return &h.value_handler;
+		if (a) {
+			if (!a->accepts_value()) {
+				this->fail(error_code::unexpected_value, arg, equals_pos, key, value);
+				return false;
 			}
-			ASSERT(i < arg.size())
-			h.value_handler(arg.substr(i));
-			break;
+			t.kind = token_kind::key;
+			t.id = a->id;
+			t.has_value = true;
+			t.value = value;
+			this->current_argument = a;
+			this->current_arg = arg;
+			this->current_key = key;
+			this->current_value_offset = equals_pos + 1;
+			return true;
+		}
+	} else {
+		if (a) {
+			if (!a->accepts_no_value()) {
+				this->fail(error_code::missing_value, arg, arg.size(), key);
+				return false;
+			}
+			t.kind = token_kind::key;
+			t.id = a->id;
+			t.has_value = false;
+			t.value = std::string_view();
+			this->current_argument = a;
+			this->current_arg = arg;
+			this->current_key = key;
+			this->current_value_offset = arg.size();
+			return true;
+		} else if (arg.size() == 2) {
+			ASSERT(arg == "--")
+			// default handling of '--' argument is disabling key arguments parsing
+			this->is_key_parsing_enabled = false;
+			return false;
 		}
-		ASSERT(!iter->second.value_handler)
-		iter->second.boolean_handler();
 	}
-	return nullptr;
+	this->fail(error_code::unknown_argument, arg, long_key_prefix.size(), key);
+	if (this->is_suggesting_similar_keys) {
+		this->error_info.suggestions = this->owner.suggest(key);
+	}
+	return false;
 }
 
-void parser::stop()
+bool parser::token_range::read_batch_key(token& t)
 {
-	this->stop_parsing_requested = true;
-}
+	auto arg = this->batch;
+	auto i = this->batch_pos;
 
-void parser::add(std::function<void(
-					 std::string_view command,
-					 utki::span<std::string_view> args //
-				 )> subcommand_handler)
-{
-	if (this->subcommand_handler) {
-		throw std::logic_error("subcommand handler is already added");
+	ASSERT(i < arg.size())
+
+	auto a = this->owner.find_argument(arg[i]);
+	if (!a) {
+		this->fail(error_code::unknown_argument, arg, i, arg.substr(i, 1));
+		if (this->is_suggesting_similar_keys && i == 1) {
+			// the first key of the batch is unknown, so it could be a long key given with one dash
+			this->error_info.suggestions = this->owner.suggest(arg.substr(1, arg.find('=') - 1));
+		}
+		return false;
+	}
+
+	auto key = arg.substr(i, 1);
+	++i;
+
+	t.kind = token_kind::key;
+	t.id = a->id;
+	this->current_argument = a;
+	this->current_arg = arg;
+	this->current_key = key;
+	this->current_value_offset = i;
+
+	if (a->accepts_no_value()) {
+		t.has_value = false;
+		t.value = std::string_view();
+		if (i == arg.size()) {
+			this->batch = std::string_view();
+		} else {
+			this->batch_pos = i;
+		}
+		return true;
+	}
+
+	ASSERT(a->accepts_value())
+
+	// the rest of the batch is the value of the last key
+	this->batch = std::string_view();
+	t.has_value = true;
+
+	if (i != arg.size()) {
+		ASSERT(i < arg.size())
+		t.value = arg.substr(i);
+		return true;
+	}
+
+	if (this->stream && !this->is_reading_response_file()) {
+		// reading the next argument from the stream can overwrite the current one
+		arg = this->stream->pin(arg);
+		this->current_arg = arg;
+		this->current_key = arg.substr(i - 1, 1);
+		key = this->current_key;
+	}
+
+	// value is the next argument
+	std::string_view value;
+	if (!this->read(value)) {
+		if (!this->error_info) {
+			this->fail(error_code::missing_value, arg, arg.size(), key);
+		}
+		return false;
+	}
+	t.value = value;
+	this->current_arg = value;
+	this->current_value_offset = 0;
+	return true;
+}
+
+struct parser::parse_context {
+	// context of the outer parse() call in the same thread, if any
+	parse_context* const outer;
+
+	bool stop_parsing_requested = false;
+
+	// whether the args are only valid during parsing, e.g. they are read from response files
+	bool are_args_transient = false;
+
+	token_range reader;
+
+	// only one of these is set, parse() collects non-key arguments as strings,
+	// while parse_views() collects them as views into the args
+	std::vector<std::string>* non_key_strings = nullptr;
+	std::vector<std::string_view>* non_key_views = nullptr;
+
+	// arguments given in the command line, only tracked in case there are environment variables
+	// or config files to handle, shared with the sub-parser contexts
+	std::vector<const argument_callbacks*>* given_arguments = nullptr;
+	std::vector<const argument_callbacks*> own_given_arguments;
+
+	parse_context(
+		const parser& owner, //
+		utki::span<std::string_view> args
+	) :
+		outer(innermost_parse_context),
+		reader(owner, args)
+	{
+		innermost_parse_context = this;
+
+		// the errors are thrown by default, so the error messages need the suggestions
+		this->reader.is_suggesting_similar_keys = true;
+
+		if (owner.has_fallback_sources()) {
+			this->given_arguments = &this->own_given_arguments;
+		}
+	}
+
+	parse_context(const parse_context&) = delete;
+	parse_context& operator=(const parse_context&) = delete;
+
+	parse_context(parse_context&&) = delete;
+	parse_context& operator=(parse_context&&) = delete;
+
+	~parse_context()
+	{
+		ASSERT(innermost_parse_context == this)
+		innermost_parse_context = this->outer;
+	}
+};
+
+std::vector<std::string> parser::parse(utki::span<std::string_view> args) const
+{
+	std::vector<std::string> ret;
+
+	parse_context context(*this, args);
+	context.non_key_strings = &ret;
+
+	this->parse_arguments(context);
+	throw_parse_error(context.reader.error());
+
+	return ret;
+}
+
+std::vector<std::string> parser::parse(
+	utki::span<std::string_view> args, //
+	parse_stats& stats
+) const
+{
+	auto start = std::chrono::steady_clock::now();
+
+	stats = parse_stats();
+	stats.arguments.resize(this->arguments.size());
+
+	std::vector<std::string> ret;
+
+	parse_context context(*this, args);
+	context.non_key_strings = &ret;
+
+	utki::scope_exit stats_scope_exit([&stats, &context, start]() {
+		stats.num_arguments = context.reader.index;
+		stats.time = std::chrono::steady_clock::now() - start;
+	});
+
+	this->parse_arguments<true>(context, &stats);
+	throw_parse_error(context.reader.error());
+
+	return ret;
+}
+
+std::vector<std::string> parser::parse(std::string_view command_line) const
+{
+	// unquoted arguments cannot be longer than the command line
+	std::unique_ptr<char[]> scratch(new char[command_line.size()]);
+	tokenizer command_line_tokenizer(command_line, utki::make_span(scratch.get(), command_line.size()));
+
+	std::vector<std::string> ret;
+
+	parse_context context(*this, {});
+	context.reader.command_line = &command_line_tokenizer;
+	context.non_key_strings = &ret;
+
+	this->parse_arguments(context);
+	throw_parse_error(context.reader.error());
+
+	return ret;
+}
+
+std::vector<std::string_view> parser::parse_views(
+	int argc, //
+	const char* const* argv
+) const
+{
+	ASSERT(argc >= 1)
+	return this->parse_views(utki::make_span(argv, argc).subspan(1));
+}
+
+std::vector<std::string_view> parser::parse_views(utki::span<const char* const> args) const
+{
+	std::vector<std::string_view> sv_args;
+	sv_args.reserve(args.size());
+
+	for (const auto& a : args) {
+		sv_args.emplace_back(a);
+	}
+
+	// the views point to the argument strings, not to the sv_args, so it is ok to return them
+	return this->parse_views(sv_args);
+}
+
+std::vector<std::string_view> parser::parse_views(utki::span<std::string_view> args) const
+{
+	std::vector<std::string_view> ret;
+
+	parse_context context(*this, args);
+	context.non_key_views = &ret;
+
+	this->parse_arguments(context);
+	throw_parse_error(context.reader.error());
+
+	return ret;
+}
+
+std::vector<std::string> parser::parse(
+	std::istream& input, //
+	char delimiter,
+	size_t buffer_size
+) const
+{
+	stream_reader reader(input, delimiter, buffer_size);
+
+	std::vector<std::string> ret;
+
+	parse_context context(*this, {});
+	context.reader.stream = &reader;
+	context.non_key_strings = &ret;
+
+	this->parse_arguments(context);
+	throw_parse_error(context.reader.error());
+
+	return ret;
+}
+
+std::vector<std::string> parser::parse_fd(
+	int fd, //
+	char delimiter,
+	size_t buffer_size
+) const
+{
+	stream_reader reader(fd, delimiter, buffer_size);
+
+	std::vector<std::string> ret;
+
+	parse_context context(*this, {});
+	context.reader.stream = &reader;
+	context.non_key_strings = &ret;
+
+	this->parse_arguments(context);
+	throw_parse_error(context.reader.error());
+
+	return ret;
+}
+
+std::vector<std::string_view> parser::parse_nul_separated(std::string_view buffer) const
+{
+	std::vector<std::string_view> ret;
+
+	parse_context context(*this, {});
+	context.reader.is_nul_separated = true;
+	context.reader.nul_separated_args = buffer;
+	context.non_key_views = &ret;
+
+	this->parse_arguments(context);
+	throw_parse_error(context.reader.error());
+
+	return ret;
+}
+
+parse_error parser::try_parse(
+	utki::span<std::string_view> args, //
+	std::vector<std::string_view>& non_key_args
+) const noexcept
+{
+	parse_context context(*this, args);
+	context.non_key_views = &non_key_args;
+
+	auto& reader = context.reader;
+	reader.is_suggesting_similar_keys = false;
+
+	try {
+		this->parse_arguments(context);
+	} catch (...) {
+		reader.error_info = parse_error();
+		reader.fail(error_code::exception_thrown, reader.last_arg, 0);
+		reader.error_info.exception = std::current_exception();
+	}
+
+	return std::move(reader.error_info);
+}
+
+parser::parse_context* parser::find_current_context() const noexcept
+{
+	for (auto c = innermost_parse_context; c; c = c->outer) {
+		// the sub-parsers parse the rest of the arguments on behalf of their parent parsers
+		for (auto p = &c->reader.owner; p; p = p->parent) {
+			if (p == this) {
+				return c;
+			}
+		}
+	}
+	return nullptr;
+}
+
+void parser::reserve_collected_values(utki::span<std::string_view> args) const
+{
+	std::vector<size_t> counts(this->collectors.size(), 0);
+
+	auto count = [&counts](const argument_callbacks& argument) {
+		if (argument.collector_index != npos) {
+			++counts[argument.collector_index];
+		}
+	};
+
+	for (auto arg : args) {
+		if (arg.size() < short_key_argument_size || arg.front() != '-') {
+			continue;
+		}
+
+		if (arg.substr(0, long_key_prefix.size()) == long_key_prefix) {
+			if (arg.size() == long_key_prefix.size()) {
+				// key parsing is disabled after '--'
+				break;
+			}
+			auto key = arg.substr(long_key_prefix.size(), arg.find('=') - long_key_prefix.size());
+			if (auto argument = this->find_argument(key)) {
+				count(*argument);
+			}
+			continue;
+		}
+
+		// batch of short keys, the rest of the batch after the first key accepting value is its value
+		for (size_t i = 1; i != arg.size(); ++i) {
+			auto argument = this->find_argument(arg[i]);
+			if (!argument) {
+				break;
+			}
+			count(*argument);
+			if (!argument->accepts_no_value()) {
+				break;
+			}
+		}
+	}
+
+	for (size_t i = 0; i != this->collectors.size(); ++i) {
+		if (counts[i] != 0) {
+			const auto& c = this->collectors[i];
+			c.reserve(c.argument->binding.target, counts[i]);
+		}
+	}
+}
+
+namespace {
+// calls the function and adds the call and its duration to the handler statistics
+template <typename function_type>
+decltype(auto) call_timed(
+	parse_stats::handler_stats& stats, //
+	function_type&& func
+)
+{
+	auto start = std::chrono::steady_clock::now();
+	utki::scope_exit stats_scope_exit([&stats, start]() {
+		stats.time += std::chrono::steady_clock::now() - start;
+		++stats.num_calls;
+	});
+	return func();
+}
+} // namespace
+
+size_t parser::count_probes(std::string_view key) const noexcept
+{
+	size_t num_probes = 0;
+	for (auto p = this; p; p = p->parent) {
+		num_probes += p->arguments_table.count_probes(key);
+		if (p->arguments_table.find(key)) {
+			break;
+		}
+	}
+	return num_probes;
+}
+
+void parser::parse_arguments(parse_context& context) const
+{
+	this->parse_arguments<false>(context, nullptr);
+}
+
+template <bool with_stats>
+void parser::parse_arguments(
+	parse_context& context, //
+	[[maybe_unused]] parse_stats* stats
+) const
+{
+	auto& reader = context.reader;
+
+	if (!this->collectors.empty() && !reader.command_line && !reader.stream && !reader.is_nul_separated) {
+		this->reserve_collected_values(reader.args);
+	}
+
+	token t;
+	while (!context.stop_parsing_requested && reader.next(t)) {
+		switch (t.kind) {
+			case token_kind::key:
+				{
+					ASSERT(reader.current_argument)
+					const auto& argument = *reader.current_argument;
+
+					if (context.given_arguments) {
+						context.given_arguments->push_back(&argument);
+					}
+
+					if constexpr (with_stats) {
+						if (reader.current_arg.substr(0, long_key_prefix.size()) == long_key_prefix) {
+							++stats->num_long_keys;
+							stats->num_probes += this->count_probes(reader.current_key);
+						} else {
+							++stats->num_short_keys;
+						}
+					}
+
+					if (t.has_value && argument.binding.store == &value_binding::append_view &&
+						(context.are_args_transient || reader.is_reading_response_file() || reader.command_line ||
+						 reader.stream))
+					{
+						reader.fail(
+							error_code::value_not_viewable, //
+							reader.current_arg,
+							reader.current_value_offset,
+							reader.current_key,
+							t.value
+						);
+						break;
+					}
+
+					auto handle = [&argument, &t]() {
+						if (t.has_value) {
+							return handle_value(argument, t.value);
+						}
+						return handle_no_value(argument);
+					};
+
+					if constexpr (with_stats) {
+						if (stats->arguments.size() <= argument.id) {
+							// arguments can be added by handlers during parsing
+							stats->arguments.resize(this->arguments.size());
+						}
+						reader.check(call_timed(stats->arguments[argument.id], handle), t.value);
+					} else {
+						reader.check(handle(), t.value);
+					}
+				}
+				break;
+			case token_kind::subcommand:
+				{
+					bool are_remaining_args_transient = context.are_args_transient || reader.is_reading_response_file();
+					auto first_remaining_index = reader.index;
+
+					auto remaining = reader.remaining();
+					if (reader.error()) {
+						return;
+					}
+
+					size_t num_remaining_from_response_files =
+						reader.response_files ? reader.response_files->num_remaining_from_response_files : 0;
+
+					auto handle = [&]() {
+						auto c = this->find_subcommand(t.value);
+						if (c) {
+							parser subparser;
+							subparser.parent = this;
+							subparser.is_response_files_expansion_enabled = this->is_response_files_expansion_enabled;
+							subparser.are_key_abbreviations_enabled = this->are_key_abbreviations_enabled;
+							c->factory(subparser);
+
+							parse_context subcontext(subparser, remaining);
+							subcontext.non_key_strings = context.non_key_strings;
+							subcontext.non_key_views = context.non_key_views;
+							subcontext.are_args_transient = are_remaining_args_transient;
+							subcontext.reader.is_suggesting_similar_keys = reader.is_suggesting_similar_keys;
+							if (context.given_arguments) {
+								subcontext.given_arguments = context.given_arguments;
+							}
+
+							subparser.parse_arguments(subcontext);
+
+							context.stop_parsing_requested = subcontext.stop_parsing_requested;
+
+							if (subcontext.reader.error()) {
+								auto& e = reader.error_info;
+								e = std::move(subcontext.reader.error_info);
+
+								if (e.argument_index < num_remaining_from_response_files) {
+									// same as for the errors in response files, it is the index of the '@path' argument
+									e.argument_index = first_remaining_index - 1;
+								} else {
+									e.argument_index += first_remaining_index - num_remaining_from_response_files;
+								}
+
+								if (reader.response_files) {
+									// the views may point into the response files of this parser
+									e.storage = std::make_shared<std::pair<std::shared_ptr<const void>, std::shared_ptr<const void>>>(
+										std::move(e.storage),
+										std::move(reader.response_files)
+									);
+								}
+							}
+						} else if (this->subcommand_handler) {
+							this->subcommand_handler(t.value, remaining);
+						} else {
+							reader.fail(error_code::unknown_subcommand, t.value, 0);
+						}
+					};
+
+					if constexpr (with_stats) {
+						call_timed(stats->subcommand, handle);
+					} else {
+						handle();
+					}
+
+					if (!reader.error() && !context.stop_parsing_requested) {
+						this->handle_fallback_sources(context);
+					}
+				}
+				return;
+			case token_kind::non_key:
+				{
+					auto handle = [&]() {
+						if (this->non_key_handler) {
+							this->non_key_handler(t.value);
+						} else if (context.non_key_strings) {
+							context.non_key_strings->emplace_back(t.value);
+						} else {
+							ASSERT(context.non_key_views)
+							if (context.are_args_transient || reader.is_reading_response_file()) {
+								reader.fail(error_code::non_key_argument_not_viewable, t.value, 0);
+								return;
+							}
+							context.non_key_views->push_back(t.value);
+						}
+					};
+
+					if constexpr (with_stats) {
+						++stats->num_non_keys;
+						call_timed(stats->non_key, handle);
+					} else {
+						handle();
+					}
+
+					if (reader.error()) {
+						return;
+					}
+				}
+				break;
+		}
+	}
+
+	if (!reader.error() && !context.stop_parsing_requested) {
+		this->handle_fallback_sources(context);
+	}
+}
+
+namespace {
+const char* const* get_environment() noexcept
+{
+#if CFG_OS == CFG_OS_WINDOWS
+	return _environ;
+#elif CFG_OS == CFG_OS_MACOSX
+	// environ is not available to shared libraries on macos
+	return *_NSGetEnviron();
+#else
+	return environ;
+#endif
+}
+} // namespace
+
+void parser::handle_fallback_sources(parse_context& context) const
+{
+	this->handle_environment_variables(context);
+
+	if (!context.reader.error()) {
+		this->handle_config_files(context);
+	}
+}
+
+void parser::handle_environment_variables(parse_context& context) const
+{
+	if (this->environment_table.size() == 0) {
+		return;
+	}
+
+	auto& reader = context.reader;
+
+	ASSERT(context.given_arguments)
+	auto& given = *context.given_arguments;
+	std::sort(given.begin(), given.end(), std::less<>());
+
+	struct match {
+		const environment_variable* variable;
+		std::string_view entry;
+		size_t equals_pos;
+	};
+
+	std::vector<match> matches;
+
+	for (auto env = get_environment(); env && *env; ++env) {
+		std::string_view entry(*env);
+
+		auto equals_pos = entry.find('=');
+		if (equals_pos == std::string_view::npos) {
+			continue;
+		}
+
+		auto variable = this->environment_table.find(entry.substr(0, equals_pos));
+		if (!variable) {
+			continue;
+		}
+
+		if (std::binary_search(given.begin(), given.end(), &variable->argument, std::less<>())) {
+			continue;
+		}
+
+		matches.push_back(match{variable, entry, equals_pos});
+	}
+
+	// in case the argument has several environment variables set, only the one added first is handled
+	std::sort(matches.begin(), matches.end(), [](const auto& a, const auto& b) {
+		return a.variable->index < b.variable->index;
+	});
+
+	for (const auto& m : matches) {
+		const auto* argument = &m.variable->argument;
+
+		auto i = std::lower_bound(given.begin(), given.end(), argument, std::less<>());
+		if (i != given.end() && *i == argument) {
+			continue;
+		}
+		given.insert(i, argument);
+
+		reader.current_arg = m.entry;
+		reader.current_key = m.entry.substr(0, m.equals_pos);
+		reader.current_value_offset = m.equals_pos + 1;
+
+		handle_fallback_value(reader, *argument, true, m.entry.substr(m.equals_pos + 1));
+
+		if (reader.error()) {
+			return;
+		}
+	}
+}
+
+namespace {
+// keeps the config file mapped as long as the parse error refers to its lines
+struct config_file_storage {
+	std::string path;
+	std::optional<mapped_file> file;
+};
+
+std::string_view trim_whitespace(std::string_view str) noexcept
+{
+	constexpr std::string_view whitespace = " \t\r";
+
+	auto begin = str.find_first_not_of(whitespace);
+	if (begin == std::string_view::npos) {
+		return str.substr(str.size());
+	}
+	auto end = str.find_last_not_of(whitespace);
+	return str.substr(begin, end + 1 - begin);
+}
+} // namespace
+
+void parser::handle_config_files(parse_context& context) const
+{
+	if (this->config_files.empty()) {
+		return;
+	}
+
+	auto& reader = context.reader;
+
+	ASSERT(context.given_arguments)
+	auto& given = *context.given_arguments;
+
+	// the later added config files take precedence over the earlier added ones
+	for (auto path = this->config_files.rbegin(); path != this->config_files.rend(); ++path) {
+		std::sort(given.begin(), given.end(), std::less<>());
+		given.erase(std::unique(given.begin(), given.end()), given.end());
+
+		// the arguments handled from this file are appended after the ones taken from the sources of higher precedence,
+		// so that all occurrences of an argument within the file are handled
+		auto num_given = given.size();
+
+		auto storage = std::make_shared<config_file_storage>();
+		storage->path = *path;
+
+		try {
+			storage->file.emplace(storage->path);
+		} catch (std::system_error& e) {
+			if (e.code() == std::errc::no_such_file_or_directory) {
+				continue;
+			}
+			reader.fail(error_code::config_file_unreadable, storage->path, 0);
+			reader.error_info.exception = std::current_exception();
+			reader.error_info.file = storage->path;
+			reader.error_info.storage = std::move(storage);
+			return;
+		}
+
+		auto data = storage->file->data();
+		std::string_view text(data.data(), data.size());
+
+		for (size_t line_number = 1; !text.empty(); ++line_number) {
+			auto line_end = text.find('\n');
+			auto line = trim_whitespace(text.substr(0, line_end));
+			text = line_end == std::string_view::npos ? std::string_view() : text.substr(line_end + 1);
+
+			if (line.empty() || line.front() == '#') {
+				continue;
+			}
+
+			auto equals_pos = line.find('=');
+			bool has_value = equals_pos != std::string_view::npos;
+
+			auto key = trim_whitespace(line.substr(0, equals_pos));
+			auto value = has_value ? trim_whitespace(line.substr(equals_pos + 1)) : std::string_view();
+
+			reader.current_arg = line;
+			reader.current_key = key;
+			reader.current_value_offset = has_value ? size_t(value.data() - line.data()) : line.size();
+
+			auto argument = key.empty() ? nullptr : this->find_argument(key);
+			if (!argument) {
+				reader.fail(error_code::unknown_argument, line, 0, key);
+				if (reader.is_suggesting_similar_keys) {
+					reader.error_info.suggestions = this->suggest(key);
+				}
+			} else if (std::binary_search(given.begin(), std::next(given.begin(), num_given), argument, std::less<>())) {
+				continue;
+			} else if (has_value && argument->binding.store == &value_binding::append_view) {
+				reader.fail(
+					error_code::value_not_viewable, //
+					line,
+					reader.current_value_offset,
+					key,
+					value
+				);
+			} else {
+				given.push_back(argument);
+				handle_fallback_value(reader, *argument, has_value, value);
+			}
+
+			if (reader.error()) {
+				reader.error_info.file = storage->path;
+				reader.error_info.line = line_number;
+				reader.error_info.storage = std::move(storage);
+				return;
+			}
+		}
+	}
+}
+
+void parser::handle_fallback_value(
+	token_range& reader, //
+	const argument_callbacks& argument,
+	bool has_value,
+	std::string_view value
+)
+{
+	// empty value means no value only for the arguments with optional value handlers,
+	// for boolean arguments, including the bound ones, it is not one of the valid boolean values
+	if (!has_value || (value.empty() && argument.default_handler)) {
+		if (!argument.accepts_no_value()) {
+			reader.fail(
+				error_code::missing_value, //
+				reader.current_arg,
+				reader.current_value_offset,
+				reader.current_key
+			);
+			return;
+		}
+		reader.check(handle_no_value(argument), value);
+	} else if (argument.accepts_value()) {
+		reader.check(handle_value(argument, value), value);
+	} else {
+		// boolean arguments are only handled in case the value is true
+		bool enabled = false;
+		auto result = parse_boolean(value, enabled);
+		if (result == conversion_result::ok && enabled) {
+			result = handle_no_value(argument);
+		}
+		reader.check(result, value);
+	}
+}
+
+conversion_result parser::handle_value(
+	const argument_callbacks& argument, //
+	std::string_view value
+)
+{
+	if (!argument.binding) {
+		auto h = std::get_if<value_handler_type>(&argument.handler);
+		ASSERT(h)
+		(*h)(value);
+		return conversion_result::ok;
+	}
+
+	return argument.binding(value);
+}
+
+conversion_result parser::handle_no_value(const argument_callbacks& argument)
+{
+	if (!argument.binding) {
+		if (argument.default_handler) {
+			(*argument.default_handler)();
+		} else {
+			auto h = std::get_if<boolean_handler_type>(&argument.handler);
+			ASSERT(h)
+			(*h)();
+		}
+		return conversion_result::ok;
+	}
+
+	ASSERT(argument.binding.implicit_value)
+	return handle_value(argument, argument.binding.implicit_value);
+}
+
+void parser::stop() const noexcept
+{
+	auto context = this->find_current_context();
+	if (context) {
+		context->stop_parsing_requested = true;
+	}
+}
+
+void parser::set_key_parsing(bool enable)
+{
+	auto context = this->find_current_context();
+	if (context) {
+		context->reader.set_key_parsing(enable);
+	} else {
+		this->throw_if_frozen();
+		this->is_key_parsing_enabled_initially = enable;
+	}
+}
+
+void parser::freeze()
+{
+	this->frozen = true;
+
+	// abbreviations cannot be enabled after freezing, so the prefix tree is only needed in case they are enabled
+	if (this->are_key_abbreviations_enabled) {
+		// build the prefix tree in advance, so that parsing does not modify the frozen parser
+		this->get_key_trie();
+	}
+}
+
+void parser::throw_if_frozen() const
+{
+	if (this->frozen) {
+		throw std::logic_error("parser is frozen, no more arguments can be added and settings cannot be changed");
+	}
+}
+
+void parser::add(subcommand_handler_type subcommand_handler)
+{
+	this->throw_if_frozen();
+
+	if (this->subcommand_handler) {
+		throw std::logic_error("subcommand handler is already added");
 	}
 	this->subcommand_handler = std::move(subcommand_handler);
 }
+
+void parser::add_subcommand(
+	string_arg name, //
+	subcommand_factory_type factory
+)
+{
+	this->throw_if_frozen();
+
+	if (this->subcommands_table.find(name.view())) {
+		std::stringstream ss;
+		ss << "subcommand '" << name.view() << "' already exists";
+		throw std::logic_error(ss.str());
+	}
+
+	auto key = this->store(name);
+
+	this->subcommands.push_back(this->storage.make<subcommand>(subcommand{std::move(factory)}));
+
+	utki::scope_exit subcommand_scope_exit([this] {
+		this->subcommands.pop_back();
+	});
+
+	this->subcommands_table.insert(key, *this->subcommands.back());
+
+	subcommand_scope_exit.release();
+}
+
+void parser::add_environment_variable(
+	size_t argument_id, //
+	string_arg name
+)
+{
+	this->throw_if_frozen();
+
+	if (argument_id >= this->arguments.size()) {
+		throw std::logic_error("argument with the given id does not exist");
+	}
+
+	if (this->environment_table.find(name.view())) {
+		std::stringstream ss;
+		ss << "environment variable '" << name.view() << "' is already added";
+		throw std::logic_error(ss.str());
+	}
+
+	auto variable = this->storage.make<environment_variable>(
+		environment_variable{*this->arguments[argument_id], this->environment_variables.size()}
+	);
+	this->environment_table.insert(this->store(name), *variable);
+	this->environment_variables.push_back(std::move(variable));
+}
+
+void parser::add_config_file(string_arg path)
+{
+	this->throw_if_frozen();
+
+	this->config_files.push_back(this->store(path));
+}
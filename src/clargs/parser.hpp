@@ -26,25 +26,64 @@ SOFTWARE.
 
 #pragma once
 
-#include <functional>
-#include <map>
-#include <unordered_map>
+#include <array>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <variant>
 #include <vector>
 
 #include <utki/span.hpp>
 
+#include "arena.hpp"
+#include "inline_function.hpp"
+#include "key_trie.hpp"
+#include "lookup_table.hpp"
+#include "parse_error.hpp"
+#include "parse_stats.hpp"
+#include "static_string.hpp"
+#include "value_binding.hpp"
+#include "value_kind.hpp"
+
 namespace clargs {
 
+class stream_reader;
+class tokenizer;
+
 /**
  * @brief Parser of command line arguments.
  * This class represents a parser of command line arguments.
  * It holds information about all known command line arguments with corresponding
  * handler functions. When parsing command line aruments it calls user supplied callback
  * functions for each encountered known argument from command line.
+ * Keys and descriptions given to the registration functions are copied by the parser,
+ * unless given as static_string, see "_static" literal.
  */
 class parser
 {
 public:
+	/**
+	 * @brief Size of the inline buffer of the handlers.
+	 * Handlers which do not fit into the buffer, e.g. lambdas capturing more than two pointers,
+	 * are allocated on the heap. Use function_ref to register bigger handlers without allocation,
+	 * in case the handler outlives the parser.
+	 */
+	constexpr static size_t handler_buffer_size = 2 * sizeof(void*);
+
+	using value_handler_type = inline_function<void(std::string_view), handler_buffer_size>;
+	using boolean_handler_type = inline_function<void(), handler_buffer_size>;
+
+	using subcommand_handler_type = inline_function<
+		void(
+			std::string_view command, //
+			utki::span<std::string_view> args
+		),
+		handler_buffer_size>;
+
+	using subcommand_factory_type = inline_function<void(parser& subparser), handler_buffer_size>;
+
 	/**
 	 * @brief Register command line argument.
 	 * Registers command line agrument which has short one-letter name,
@@ -53,20 +92,20 @@ public:
 	 * @param long_key - long, dash separated argument name.
 	 * @param description - argument description.
 	 * @param value_handler - callback function which is called to handle value of the argument.
+	 * @return id of the argument, see token::id.
 	 */
-	void add(
+	size_t add(
 		char short_key, //
-		std::string long_key,
-		std::string description,
-		std::function<void(std::string_view)> value_handler
+		string_arg long_key,
+		string_arg description,
+		value_handler_type value_handler
 	)
 	{
-		this->add_argument(
+		return this->add_argument(
 			short_key, //
-			std::move(long_key),
-			std::move(description),
-			std::move(value_handler),
-			nullptr
+			long_key,
+			description,
+			{std::move(value_handler), nullptr}
 		);
 	}
 
@@ -77,17 +116,18 @@ public:
 	 * @param short_key - one letter argument name.
 	 * @param description - argument description.
 	 * @param value_handler - callback function which is called to handle value of the argument.
+	 * @return id of the argument, see token::id.
 	 */
-	void add(
+	size_t add(
 		char short_key, //
-		std::string description,
-		std::function<void(std::string_view)> value_handler
+		string_arg description,
+		value_handler_type value_handler
 	)
 	{
-		this->add(
+		return this->add(
 			short_key, //
-			std::string(),
-			std::move(description),
+			std::string_view(),
+			description,
 			std::move(value_handler)
 		);
 	}
@@ -100,20 +140,20 @@ public:
 	 * @param description - argument description.
 	 * @param value_handler - callback function which is called to handle value of the argument.
 	 * @param default_value_handler - callback function which is called when the argument has no value given.
+	 * @return id of the argument, see token::id.
 	 */
-	void add(
-		std::string long_key, //
-		std::string description,
-		std::function<void(std::string_view)> value_handler,
-		std::function<void()> default_value_handler = nullptr
+	size_t add(
+		string_arg long_key, //
+		string_arg description,
+		value_handler_type value_handler,
+		boolean_handler_type default_value_handler = nullptr
 	)
 	{
-		this->add_argument(
+		return this->add_argument(
 			'\0', //
-			std::move(long_key),
-			std::move(description),
-			std::move(value_handler),
-			std::move(default_value_handler)
+			long_key,
+			description,
+			{std::move(value_handler), std::move(default_value_handler)}
 		);
 	}
 
@@ -126,20 +166,20 @@ public:
 	 * @param long_key - long, dash separated argument name.
 	 * @param description - argument description.
 	 * @param boolean_handler - callback function which is called to handle the argument presence in the command line.
+	 * @return id of the argument, see token::id.
 	 */
-	void add(
+	size_t add(
 		char short_key, //
-		std::string long_key,
-		std::string description,
-		std::function<void()> boolean_handler
+		string_arg long_key,
+		string_arg description,
+		boolean_handler_type boolean_handler
 	)
 	{
-		this->add_argument(
+		return this->add_argument(
 			short_key, //
-			std::move(long_key),
-			std::move(description),
-			nullptr,
-			std::move(boolean_handler)
+			long_key,
+			description,
+			{nullptr, std::move(boolean_handler)}
 		);
 	}
 
@@ -151,17 +191,18 @@ public:
 	 * @param short_key - one letter argument name.
 	 * @param description - argument description.
 	 * @param boolean_handler - callback function which is called to handle the argument presence in the command line.
+	 * @return id of the argument, see token::id.
 	 */
-	void add(
+	size_t add(
 		char short_key, //
-		std::string description,
-		std::function<void()> boolean_handler
+		string_arg description,
+		boolean_handler_type boolean_handler
 	)
 	{
-		this->add(
+		return this->add(
 			short_key, //
-			std::string(),
-			std::move(description),
+			std::string_view(),
+			description,
 			std::move(boolean_handler)
 		);
 	}
@@ -174,27 +215,342 @@ public:
 	 * @param long_key - long, dash separated argument name.
 	 * @param description - argument description.
 	 * @param boolean_handler - callback function which is called to handle the argument presence in the command line.
+	 * @return id of the argument, see token::id.
 	 */
-	void add(
-		std::string long_key, //
-		std::string description,
-		std::function<void()> boolean_handler
+	size_t add(
+		string_arg long_key, //
+		string_arg description,
+		boolean_handler_type boolean_handler
 	)
 	{
-		this->add(
+		return this->add(
 			'\0', //
-			std::move(long_key),
-			std::move(description),
+			long_key,
+			description,
 			std::move(boolean_handler)
 		);
 	}
 
+	/**
+	 * @brief Register command line argument bound to a variable.
+	 * Registers command line agrument which has short one-letter name,
+	 * long dash-separated name and description. The argument value is converted to the type of the variable
+	 * and stored to the variable. Integral and floating point values are converted with std::from_chars().
+	 * In case the value cannot be converted, parse() throws std::invalid_argument.
+	 * The bool variable argument can be given without value, which means 'true', or with one of the values
+	 * "true", "yes", "on", "1", "false", "no", "off", "0".
+	 * @param short_key - one letter argument name.
+	 * @param long_key - long, dash separated argument name.
+	 * @param description - argument description.
+	 * @param value - variable to store the argument value to. Must outlive the parser.
+	 * @return id of the argument, see token::id.
+	 */
+	template <typename value_type, std::enable_if_t<is_bindable_v<value_type>, bool> = true>
+	size_t add(
+		char short_key, //
+		string_arg long_key,
+		string_arg description,
+		value_type& value
+	)
+	{
+		return this->add_argument(
+			short_key, //
+			long_key,
+			description,
+			argument_handlers{nullptr, nullptr, value_binding::make(value)}
+		);
+	}
+
+	/**
+	 * @brief Register command line argument bound to a variable.
+	 * Registers command line agrument which has short one-letter name and description.
+	 * See add(char, string_arg, string_arg, value_type&) for details.
+	 * @param short_key - one letter argument name.
+	 * @param description - argument description.
+	 * @param value - variable to store the argument value to. Must outlive the parser.
+	 * @return id of the argument, see token::id.
+	 */
+	template <typename value_type, std::enable_if_t<is_bindable_v<value_type>, bool> = true>
+	size_t add(
+		char short_key, //
+		string_arg description,
+		value_type& value
+	)
+	{
+		return this->add(
+			short_key, //
+			std::string_view(),
+			description,
+			value
+		);
+	}
+
+	/**
+	 * @brief Register command line argument bound to a variable.
+	 * Registers command line agrument which has long dash-separated name and description.
+	 * See add(char, string_arg, string_arg, value_type&) for details.
+	 * @param long_key - long, dash separated argument name.
+	 * @param description - argument description.
+	 * @param value - variable to store the argument value to. Must outlive the parser.
+	 * @return id of the argument, see token::id.
+	 */
+	template <typename value_type, std::enable_if_t<is_bindable_v<value_type>, bool> = true>
+	size_t add(
+		string_arg long_key, //
+		string_arg description,
+		value_type& value
+	)
+	{
+		return this->add(
+			'\0', //
+			long_key,
+			description,
+			value
+		);
+	}
+
+	/**
+	 * @brief Register command line argument collecting its values to a vector.
+	 * Registers command line agrument which has short one-letter name,
+	 * long dash-separated name and description. The argument can be given any number of times,
+	 * values of all its occurrences are converted to the type of the vector elements, see add(char, string_arg, string_arg, value_type&),
+	 * and appended to the vector in the order of occurrence.
+	 * Before parsing an array of arguments, the number of occurrences is estimated by scanning the arguments,
+	 * and the vector capacity is reserved accordingly, so that the vector is usually not reallocated during parsing.
+	 * The occurrences in response files are not counted, so the vector can be reallocated in that case.
+	 * In case of std::vector<std::string_view>, the values are views into the parsed arguments, so no value text is copied.
+	 * Such values cannot be read from response files, command line strings or streams, since those only live
+	 * during parsing, parse() throws std::logic_error in that case, use std::vector<std::string> instead.
+	 * @param short_key - one letter argument name.
+	 * @param long_key - long, dash separated argument name.
+	 * @param description - argument description.
+	 * @param values - vector to append the argument values to. Must outlive the parser.
+	 * @return id of the argument, see token::id.
+	 */
+	template <typename value_type, std::enable_if_t<is_collectable_v<value_type>, bool> = true>
+	size_t add(
+		char short_key, //
+		string_arg long_key,
+		string_arg description,
+		std::vector<value_type>& values
+	)
+	{
+		return this->add_collecting_argument(
+			short_key, //
+			long_key,
+			description,
+			value_binding::make(values),
+			[](void* values, size_t num_values) {
+				auto& v = *static_cast<std::vector<value_type>*>(values);
+				v.reserve(v.size() + num_values);
+			}
+		);
+	}
+
+	/**
+	 * @brief Register command line argument collecting its values to a vector.
+	 * Registers command line agrument which has short one-letter name and description.
+	 * See add(char, string_arg, string_arg, std::vector<value_type>&) for details.
+	 * @param short_key - one letter argument name.
+	 * @param description - argument description.
+	 * @param values - vector to append the argument values to. Must outlive the parser.
+	 * @return id of the argument, see token::id.
+	 */
+	template <typename value_type, std::enable_if_t<is_collectable_v<value_type>, bool> = true>
+	size_t add(
+		char short_key, //
+		string_arg description,
+		std::vector<value_type>& values
+	)
+	{
+		return this->add(
+			short_key, //
+			std::string_view(),
+			description,
+			values
+		);
+	}
+
+	/**
+	 * @brief Register command line argument collecting its values to a vector.
+	 * Registers command line agrument which has long dash-separated name and description.
+	 * See add(char, string_arg, string_arg, std::vector<value_type>&) for details.
+	 * @param long_key - long, dash separated argument name.
+	 * @param description - argument description.
+	 * @param values - vector to append the argument values to. Must outlive the parser.
+	 * @return id of the argument, see token::id.
+	 */
+	template <typename value_type, std::enable_if_t<is_collectable_v<value_type>, bool> = true>
+	size_t add(
+		string_arg long_key, //
+		string_arg description,
+		std::vector<value_type>& values
+	)
+	{
+		return this->add(
+			'\0', //
+			long_key,
+			description,
+			values
+		);
+	}
+
+	/**
+	 * @brief Register command line argument bound to an enumeration variable.
+	 * Registers command line agrument which has short one-letter name,
+	 * long dash-separated name and description. The argument value is looked up in the
+	 * names table and the corresponding enumeration value is stored to the variable.
+	 * In case the value is not found in the table, parse() throws std::invalid_argument.
+	 * @param short_key - one letter argument name.
+	 * @param long_key - long, dash separated argument name.
+	 * @param description - argument description.
+	 * @param value - variable to store the argument value to. Must outlive the parser.
+	 * @param names - table of enumeration value names. Must outlive the parser.
+	 * @return id of the argument, see token::id.
+	 */
+	template <typename enum_type, size_t num_values>
+	size_t add(
+		char short_key, //
+		string_arg long_key,
+		string_arg description,
+		enum_type& value,
+		const enum_names<enum_type, num_values>& names
+	)
+	{
+		return this->add_argument(
+			short_key, //
+			long_key,
+			description,
+			argument_handlers{nullptr, nullptr, value_binding::make(value, names)}
+		);
+	}
+
+	/**
+	 * @brief Register command line argument bound to an enumeration variable.
+	 * Registers command line agrument which has short one-letter name and description.
+	 * See add(char, string_arg, string_arg, enum_type&, const enum_names<enum_type, num_values>&) for details.
+	 * @param short_key - one letter argument name.
+	 * @param description - argument description.
+	 * @param value - variable to store the argument value to. Must outlive the parser.
+	 * @param names - table of enumeration value names. Must outlive the parser.
+	 * @return id of the argument, see token::id.
+	 */
+	template <typename enum_type, size_t num_values>
+	size_t add(
+		char short_key, //
+		string_arg description,
+		enum_type& value,
+		const enum_names<enum_type, num_values>& names
+	)
+	{
+		return this->add(
+			short_key, //
+			std::string_view(),
+			description,
+			value,
+			names
+		);
+	}
+
+	/**
+	 * @brief Register command line argument bound to an enumeration variable.
+	 * Registers command line agrument which has long dash-separated name and description.
+	 * See add(char, string_arg, string_arg, enum_type&, const enum_names<enum_type, num_values>&) for details.
+	 * @param long_key - long, dash separated argument name.
+	 * @param description - argument description.
+	 * @param value - variable to store the argument value to. Must outlive the parser.
+	 * @param names - table of enumeration value names. Must outlive the parser.
+	 * @return id of the argument, see token::id.
+	 */
+	template <typename enum_type, size_t num_values>
+	size_t add(
+		string_arg long_key, //
+		string_arg description,
+		enum_type& value,
+		const enum_names<enum_type, num_values>& names
+	)
+	{
+		return this->add(
+			'\0', //
+			long_key,
+			description,
+			value,
+			names
+		);
+	}
+
+	/**
+	 * @brief Register command line argument without handler.
+	 * Registers command line agrument which has short one-letter name,
+	 * long dash-separated name and description, but no handler.
+	 * Such arguments are meant to be handled via the tokens() API, parse() just accepts them.
+	 * @param short_key - one letter argument name.
+	 * @param long_key - long, dash separated argument name.
+	 * @param description - argument description.
+	 * @param value - kind of the argument value.
+	 * @return id of the argument, see token::id.
+	 */
+	size_t add(
+		char short_key, //
+		string_arg long_key,
+		string_arg description,
+		value_kind value
+	);
+
+	/**
+	 * @brief Register command line argument without handler.
+	 * Registers command line agrument which has short one-letter name and description, but no handler.
+	 * See add(char, string_arg, string_arg, value_kind) for details.
+	 * @param short_key - one letter argument name.
+	 * @param description - argument description.
+	 * @param value - kind of the argument value.
+	 * @return id of the argument, see token::id.
+	 */
+	size_t add(
+		char short_key, //
+		string_arg description,
+		value_kind value
+	)
+	{
+		return this->add(
+			short_key, //
+			std::string_view(),
+			description,
+			value
+		);
+	}
+
+	/**
+	 * @brief Register command line argument without handler.
+	 * Registers command line agrument which has long dash-separated name and description, but no handler.
+	 * See add(char, string_arg, string_arg, value_kind) for details.
+	 * @param long_key - long, dash separated argument name.
+	 * @param description - argument description.
+	 * @param value - kind of the argument value.
+	 * @return id of the argument, see token::id.
+	 */
+	size_t add(
+		string_arg long_key, //
+		string_arg description,
+		value_kind value
+	)
+	{
+		return this->add(
+			'\0', //
+			long_key,
+			description,
+			value
+		);
+	}
+
 	/**
 	 * @brief Add handler for non-key arguments.
 	 * @param non_key_handler - handler callback for non-key arguments.
 	 */
-	void add(std::function<void(std::string_view)> non_key_handler)
+	void add(value_handler_type non_key_handler)
 	{
+		this->throw_if_frozen();
+
 		if (this->non_key_handler) {
 			throw std::logic_error("non-key handler is already added");
 		}
@@ -213,10 +569,72 @@ public:
 	 * Subcommand is only handled if key parsing is enabled, which is default (see set_key_parsing()).
 	 * @param subcommand_handler - handler callback for subcommand.
 	 */
-	void add(std::function<void(
-				 std::string_view command,
-				 utki::span<std::string_view> args //
-			 )> subcommand_handler);
+	void add(subcommand_handler_type subcommand_handler);
+
+	/**
+	 * @brief Add subcommand.
+	 * Registers a subcommand with the given name. The subcommand is a first non-key argument
+	 * which goes before the '--' delimeter, see add(subcommand_handler_type).
+	 * When parsing encounters the subcommand, a sub-parser is created and the factory function is called
+	 * to register the subcommand's arguments to it. Then the rest of the arguments are parsed with the sub-parser.
+	 * So, only the invoked subcommand's arguments are ever registered.
+	 * The sub-parser also recognizes all the arguments of this parser, unless they are overridden by
+	 * the sub-parser's own arguments. Those are looked up in this parser's tables, not copied to the sub-parser.
+	 * Non-key arguments of the subcommand are returned by the parse() call,
+	 * in case the sub-parser does not have the non-key arguments handler.
+	 * In case the first non-key argument is not a registered subcommand, the subcommand handler is called,
+	 * if added, otherwise parsing fails with error_code::unknown_subcommand.
+	 * @param name - name of the subcommand.
+	 * @param factory - function which registers the subcommand's arguments to the given sub-parser.
+	 */
+	void add_subcommand(
+		string_arg name, //
+		subcommand_factory_type factory
+	);
+
+	/**
+	 * @brief Add environment variable fallback of an argument.
+	 * In case the argument is not given in the command line, but the environment variable is set,
+	 * then the argument is handled as if it was given with the value of the environment variable.
+	 * So, the command line takes precedence over the environment.
+	 * Environment is read once per parse() call, after parsing the command line, by walking all
+	 * the environment variables and looking up each of them in a hash table of the added ones.
+	 * Boolean arguments are handled in case the variable value is one of "true", "yes", "on", "1"
+	 * and are not handled in case of "false", "no", "off", "0", see parse_boolean(),
+	 * other values, including the empty one, are reported as error_code::invalid_value.
+	 * Arguments with optional value are handled without value in case the variable value is empty.
+	 * Errors in the environment variable values are reported same way as the command line errors,
+	 * with the "NAME=value" environment entry as the offending argument.
+	 * Environment variables are not read by the tokens() range,
+	 * neither in case the parsing is stopped, see stop().
+	 * An argument can have several environment variables, in which case the one added first among the set ones is used,
+	 * regardless of the order of the variables in the environment.
+	 * @param argument_id - id of the argument, as returned by add().
+	 * @param name - name of the environment variable.
+	 */
+	void add_environment_variable(
+		size_t argument_id, //
+		string_arg name
+	);
+
+	/**
+	 * @brief Add config file.
+	 * Config file consists of "key = value" lines, where key is the long key of an argument.
+	 * Whitespace around the key and the value is ignored, empty lines and lines starting with '#' are skipped.
+	 * A line with only the key is handled same way as the key without value in the command line.
+	 * Boolean arguments accept the values same way as the environment variables, see add_environment_variable().
+	 * Config files are read on each parse() call, after parsing the command line and the environment variables.
+	 * Each file is memory-mapped and its lines are handled in place, without copying.
+	 * Each argument is taken from the source of the highest precedence which has it and all its occurrences in that
+	 * source are handled in order. The command line takes precedence over the environment variables, which take
+	 * precedence over the config files, the later added config files take precedence over the earlier added ones.
+	 * Since the values are only valid during parsing, they cannot be collected as views.
+	 * Errors in config files are reported with the line as the offending argument, see parse_error::file.
+	 * Config files which do not exist are skipped.
+	 * Config files are not read by the tokens() range, neither in case the parsing is stopped, see stop().
+	 * @param path - path to the config file.
+	 */
+	void add_config_file(string_arg path);
 
 	/**
 	 * @brief Enable or disable key arguments parsing.
@@ -225,20 +643,63 @@ public:
 	 * By default, after encountering '--' argument the key arguments parsing is disabled, user can override this
 	 * behaviour by overriding handling of long-name-only argument with empty long name and disable the key
 	 * parsing from within the handling callback.
-	 * It is ok to call this function from within the arguments handling callback functions.
+	 * It is ok to call this function from within the arguments handling callback functions,
+	 * in that case it only affects the ongoing parsing. Otherwise, it sets whether the key arguments parsing
+	 * is enabled at the beginning of each subsequent parse() call, which is only allowed before freezing the parser.
 	 * @param enable - if true, key arguments parsing will be enabled, otherwise - disabled.
+	 * @throw std::logic_error - in case called outside of parsing and the parser is frozen.
 	 */
-	void set_key_parsing(bool enable) noexcept
-	{
-		this->is_key_parsing_enabled = enable;
-	}
+	void set_key_parsing(bool enable);
 
 	[[deprecated("use set_key_parsing(bool)")]]
-	void enable_key_parsing(bool enable) noexcept
+	void enable_key_parsing(bool enable)
 	{
 		this->set_key_parsing(enable);
 	}
 
+	/**
+	 * @brief Enable or disable response files expansion.
+	 * By default response files expansion is disabled.
+	 * If enabled, then each argument of the form '@path', encountered while key arguments parsing is enabled,
+	 * is replaced by the arguments read from the file at the given path. Arguments in the file are separated by
+	 * whitespace, single and double quotes and backslash escapes are supported the same way as in POSIX shell.
+	 * Response files can refer to other response files.
+	 * The response file is memory mapped and the arguments are passed to the handlers as views into the mapped memory,
+	 * those views are valid until the parse() call returns.
+	 * The '@path' argument given as a value of a short key argument in the next command line argument is not expanded.
+	 * Since non-key arguments read from response files cannot outlive the parse() call,
+	 * parse_views() throws std::logic_error when such an argument has to be returned,
+	 * use parse() or the non-key arguments handler in that case.
+	 * @param enable - if true, response files expansion will be enabled, otherwise - disabled.
+	 * @throw std::logic_error - in case the parser is frozen.
+	 */
+	void set_response_files_expansion(bool enable)
+	{
+		this->throw_if_frozen();
+		this->is_response_files_expansion_enabled = enable;
+	}
+
+	/**
+	 * @brief Enable or disable long key abbreviations.
+	 * By default long key abbreviations are disabled.
+	 * If enabled, then a long key argument which is not a registered key, but is an unambiguous prefix of one,
+	 * is handled as that key, e.g. '--verb' is handled as '--verbose', as long as no other long key starts with 'verb'.
+	 * In case the prefix is ambiguous, then error_code::ambiguous_argument is reported with all the matching keys
+	 * as the candidates.
+	 * Exact keys are looked up same way as without abbreviations, the abbreviations are only looked up in case
+	 * there is no exact match, in a prefix tree of the long keys. The prefix tree is built by freeze(),
+	 * or on the first lookup in case the parser is not frozen.
+	 * Sub-parsers inherit the setting.
+	 * Keys of the config files cannot be abbreviated.
+	 * @param enable - if true, long key abbreviations will be enabled, otherwise - disabled.
+	 * @throw std::logic_error - in case the parser is frozen.
+	 */
+	void set_key_abbreviations(bool enable)
+	{
+		this->throw_if_frozen();
+		this->are_key_abbreviations_enabled = enable;
+	}
+
 	/**
 	 * @brief Parse command line arguments.
 	 * Parses the command line arguments.
@@ -246,7 +707,7 @@ public:
 	 * @return array of non-key arguments, in case the non-key arguments handler is not added.
 	 * @return empty vector, in case the non-key arguments handler is added.
 	 */
-	std::vector<std::string> parse(utki::span<std::string_view> args);
+	std::vector<std::string> parse(utki::span<std::string_view> args) const;
 
 	/**
 	 * @brief Parse command line arguments.
@@ -255,7 +716,22 @@ public:
 	 * @return array of non-key arguments, in case the non-key arguments handler is not added.
 	 * @return empty vector, in case the non-key arguments handler is added.
 	 */
-	std::vector<std::string> parse(utki::span<const char* const> args);
+	std::vector<std::string> parse(utki::span<const char* const> args) const;
+
+	/**
+	 * @brief Parse command line arguments and collect statistics.
+	 * Same as parse(utki::span<std::string_view>), but also collects statistics of the parsing,
+	 * like number of key lookups and time spent in the handlers, to find out where the parsing time goes.
+	 * Parsing without statistics is compiled separately, so it does not pay anything for the statistics collection.
+	 * @param args - array of command line arguments, NOT including the executable filename as first item.
+	 * @param stats - where to store the statistics, previous contents are discarded.
+	 * @return array of non-key arguments, in case the non-key arguments handler is not added.
+	 * @return empty vector, in case the non-key arguments handler is added.
+	 */
+	std::vector<std::string> parse(
+		utki::span<std::string_view> args, //
+		parse_stats& stats
+	) const;
 
 	/**
 	 * @brief Parse command line arguments.
@@ -265,13 +741,248 @@ public:
 	 * @param argv - array of arguments, first item is the executable filename.
 	 * @return array of non-key arguments.
 	 */
-	std::vector<std::string> parse(int argc, const char* const* argv);
+	std::vector<std::string> parse(int argc, const char* const* argv) const;
+
+	/**
+	 * @brief Parse command line given as a single string.
+	 * The command line is split into arguments separated by whitespace. Quoting and escaping
+	 * follow POSIX shell rules: text in single quotes is taken literally, in double quotes
+	 * backslash only escapes '"' and '\\', outside of quotes backslash escapes any following character.
+	 * Arguments which do not have any quotes or escapes are passed to the handlers as views into the command line,
+	 * others are unquoted into a temporary buffer which is valid until the parse() call returns.
+	 * @param command_line - command line, NOT including the executable filename.
+	 * @return array of non-key arguments, in case the non-key arguments handler is not added.
+	 * @return empty vector, in case the non-key arguments handler is added.
+	 */
+	std::vector<std::string> parse(std::string_view command_line) const;
+
+	/**
+	 * @brief Parse command line arguments without copying them.
+	 * Same as parse(utki::span<std::string_view>), but the returned non-key arguments
+	 * are views into the given arguments, so no argument text is copied.
+	 * @param args - array of command line arguments, NOT including the executable filename as first item.
+	 * @return array of views of non-key arguments, in case the non-key arguments handler is not added.
+	 *         The views are valid as long as the argument strings referred by the args are alive.
+	 * @return empty vector, in case the non-key arguments handler is added.
+	 */
+	std::vector<std::string_view> parse_views(utki::span<std::string_view> args) const;
+
+	/**
+	 * @brief Parse command line arguments without copying them.
+	 * Same as parse(utki::span<const char* const>), but the returned non-key arguments
+	 * are views into the given argument strings.
+	 * @param args - array of command line arguments, NOT including the executable filename as first item.
+	 * @return array of views of non-key arguments, in case the non-key arguments handler is not added.
+	 * @return empty vector, in case the non-key arguments handler is added.
+	 */
+	std::vector<std::string_view> parse_views(utki::span<const char* const> args) const;
+
+	/**
+	 * @brief Parse command line arguments without copying them.
+	 * Same as parse(int, const char* const*), but the returned non-key arguments
+	 * are views into the argv strings.
+	 * @param argc - number of arguments.
+	 * @param argv - array of arguments, first item is the executable filename.
+	 * @return array of views of non-key arguments.
+	 */
+	std::vector<std::string_view> parse_views(int argc, const char* const* argv) const;
+
+	/**
+	 * @brief Parse command line arguments given as a NUL-separated buffer.
+	 * The buffer contains arguments each terminated by a '\0' character, like /proc/<pid>/cmdline file on Linux does.
+	 * Terminating '\0' of the last argument is optional. Note, that /proc/<pid>/cmdline starts with
+	 * the executable filename, which has to be skipped by the caller.
+	 * The buffer is walked in place, no intermediate arrays of arguments are created.
+	 * @param buffer - buffer of NUL-separated arguments.
+	 * @return array of views of non-key arguments, in case the non-key arguments handler is not added.
+	 *         The views are valid as long as the buffer is alive.
+	 * @return empty vector, in case the non-key arguments handler is added.
+	 */
+	std::vector<std::string_view> parse_nul_separated(std::string_view buffer) const;
+
+	constexpr static size_t default_stream_buffer_size = 0x10000;
+
+	/**
+	 * @brief Parse command line arguments read from a stream.
+	 * Arguments are read incrementally, each terminated by the delimiter character,
+	 * into a reusable buffer, and the handlers are called as soon as each argument is read.
+	 * The buffer only grows in case a single argument does not fit into it, so the memory consumption
+	 * does not depend on the number of arguments, as long as the non-key arguments handler is added.
+	 * Views passed to the handlers are only valid during the handler call.
+	 * In case of a subcommand, all the remaining arguments are read into memory before calling the subcommand handler.
+	 * @param input - stream to read arguments from.
+	 * @param delimiter - arguments delimiter character, typically '\n' or '\0'.
+	 * @param buffer_size - initial size of the reading buffer.
+	 * @return array of non-key arguments, in case the non-key arguments handler is not added.
+	 * @return empty vector, in case the non-key arguments handler is added.
+	 * @throw std::system_error - in case of reading error.
+	 */
+	std::vector<std::string> parse(
+		std::istream& input, //
+		char delimiter = '\n',
+		size_t buffer_size = default_stream_buffer_size
+	) const;
+
+	/**
+	 * @brief Parse command line arguments read from a file descriptor.
+	 * Same as parse(std::istream&, char, size_t), but reads from the file descriptor.
+	 * Unlike the std::istream version, the arguments are handled as soon as they are available
+	 * from the file descriptor, without waiting for the buffer to be filled.
+	 * @param fd - file descriptor to read arguments from.
+	 * @param delimiter - arguments delimiter character, typically '\n' or '\0'.
+	 * @param buffer_size - initial size of the reading buffer.
+	 * @return array of non-key arguments, in case the non-key arguments handler is not added.
+	 * @return empty vector, in case the non-key arguments handler is added.
+	 * @throw std::system_error - in case of reading error.
+	 */
+	std::vector<std::string> parse_fd(
+		int fd, //
+		char delimiter = '\n',
+		size_t buffer_size = default_stream_buffer_size
+	) const;
+
+	/**
+	 * @brief Parse command line arguments without throwing exceptions.
+	 * Same as parse_views(utki::span<std::string_view>), but parsing errors are reported
+	 * via the returned parse_error object instead of throwing. No error message is formatted
+	 * unless parse_error::message() is called.
+	 * Exceptions thrown by the argument handlers are caught and reported as error_code::exception_thrown.
+	 * Parsing stops at the first error, the handlers of the arguments preceding the offending one are
+	 * already called by that time.
+	 * In order to keep rejecting invalid arguments cheap, parse_error::suggestions is not filled,
+	 * use suggest() with parse_error::key to get the similar keys for error_code::unknown_argument.
+	 * @param args - array of command line arguments, NOT including the executable filename as first item.
+	 * @param non_key_args - vector to append the views of non-key arguments to,
+	 *        in case the non-key arguments handler is not added.
+	 * @return parse_error object, which evaluates to false in case of successful parsing.
+	 */
+	parse_error try_parse(
+		utki::span<std::string_view> args, //
+		std::vector<std::string_view>& non_key_args
+	) const noexcept;
+
+	/**
+	 * @brief Find long keys similar to the given one.
+	 * Looks for the registered long keys within small edit distance from the given key,
+	 * among the keys of this parser and, for sub-parsers, of the parent parsers.
+	 * The search takes time proportional to the number of the keys, so it is intended for reporting errors.
+	 * parse() and the other throwing functions use it to make the error_code::unknown_argument error message.
+	 * @param key - unknown long key, without the '--' prefix.
+	 * @return the closest keys, in alphabetical order.
+	 * @return empty vector, in case there are no similar keys.
+	 */
+	std::vector<std::string> suggest(std::string_view key) const;
+
+	/**
+	 * @brief Kind of a command line token.
+	 */
+	enum class token_kind {
+		/**
+		 * @brief Key argument.
+		 */
+		key,
+
+		/**
+		 * @brief Non-key argument.
+		 */
+		non_key,
+
+		/**
+		 * @brief Subcommand, see add(subcommand_handler_type).
+		 * Subcommand token is only produced in case the subcommand handler is added.
+		 */
+		subcommand
+	};
+
+	constexpr static size_t npos = std::numeric_limits<size_t>::max();
+
+	/**
+	 * @brief Command line token.
+	 */
+	struct token {
+		token_kind kind = token_kind::non_key;
+
+		/**
+		 * @brief Id of the key argument.
+		 * The ids are assigned by add() in the order of arguments registration, starting from 0.
+		 * npos for non-key and subcommand tokens.
+		 */
+		size_t id = npos;
+
+		/**
+		 * @brief Whether the key argument has value.
+		 * Always true for non-key and subcommand tokens.
+		 */
+		bool has_value = false;
+
+		/**
+		 * @brief Value of the key argument, non-key argument or subcommand name.
+		 */
+		std::string_view value;
+	};
+
+	class token_range;
+
+	/**
+	 * @brief Read command line tokens one by one.
+	 * This is a pull-style alternative to parse(). The returned range produces a token for each
+	 * key argument, non-key argument and subcommand in the command line, following the same rules as parse().
+	 * Argument handlers and bindings are not called, the caller dispatches the tokens by their ids.
+	 * With a frozen parser and no response files involved, reading tokens does not allocate memory.
+	 * Reading stops at the first error, see token_range::error().
+	 * @code{.cpp}
+	 * clargs::parser p;
+	 * auto verbose_id = p.add('v', "verbose", "print more output", clargs::value_kind::none);
+	 * auto output_id = p.add('o', "output", "output file name", clargs::value_kind::required);
+	 *
+	 * auto tokens = p.tokens(args);
+	 * for(const auto& t : tokens){
+	 *     if(t.id == verbose_id){
+	 *         verbose = true;
+	 *     }else if(t.id == output_id){
+	 *         output = t.value;
+	 *     }
+	 * }
+	 * if(tokens.error()){
+	 *     std::cerr << tokens.error().message() << std::endl;
+	 * }
+	 * @endcode
+	 * @param args - array of command line arguments, NOT including the executable filename as first item.
+	 *        Must outlive the returned range.
+	 * @return range of tokens.
+	 */
+	token_range tokens(utki::span<std::string_view> args) const;
 
 	/**
 	 * @brief Stop parsing.
 	 * Can be called from within argument handler to stop further arguments parsing.
+	 * Only the ongoing parse() call of the calling thread is stopped,
+	 * the parser can be used for parsing again afterwards.
+	 */
+	void stop() const noexcept;
+
+	/**
+	 * @brief Freeze the parser.
+	 * Makes the parser immutable: prohibits adding new arguments and changing the settings,
+	 * except calling set_key_parsing() from handlers, which only affects the ongoing parsing.
+	 * Parsing with a frozen parser does not modify the parser in any way, so it is safe to call
+	 * parse() and parse_views() of a frozen parser from any number of threads simultaneously,
+	 * as long as the argument handlers are thread-safe themselves.
+	 * Calling stop() and set_key_parsing() from handlers only affects the parse() call
+	 * of the calling thread.
+	 * Parsing with a non-frozen parser is not thread-safe, since the handlers can add new arguments.
 	 */
-	void stop();
+	void freeze();
+
+	/**
+	 * @brief Check if the parser is frozen.
+	 * @return true if the parser is frozen.
+	 * @return false otherwise.
+	 */
+	bool is_frozen() const noexcept
+	{
+		return this->frozen;
+	}
 
 	constexpr static auto default_keys_width = 28;
 	constexpr static auto default_description_width = 50;
@@ -279,6 +990,8 @@ public:
 	/**
 	 * @brief Get description of the arguments.
 	 * There will be 2 characters gap between key names and key description.
+	 * The description is rendered on the first call and cached, so that subsequent calls
+	 * with the same widths do not render it again, until new arguments are added.
 	 * @param keys_width - width in characters of the key names area.
 	 * @param width - width in characters of key description area.
 	 * @return Formatted description of all the registered arguments.
@@ -288,63 +1001,482 @@ public:
 		unsigned width = default_description_width
 	) const;
 
+	/**
+	 * @brief Write description of the arguments to a stream.
+	 * Same as description(), but writes the cached description directly to the stream
+	 * instead of returning its copy.
+	 * @param out - stream to write the description to.
+	 * @param keys_width - width in characters of the key names area.
+	 * @param width - width in characters of key description area.
+	 */
+	void write_description(
+		std::ostream& out, //
+		unsigned keys_width = default_keys_width,
+		unsigned width = default_description_width
+	) const;
+
 private:
-	bool stop_parsing_requested = false;
+	// storage of the keys, descriptions and records of the registered arguments and subcommands,
+	// declared before the containers referring to it, so that it is destroyed after them
+	arena storage;
+
+	// get view of the string which is valid as long as the parser is alive
+	std::string_view store(string_arg str)
+	{
+		if (str.is_static()) {
+			return str.view();
+		}
+		return this->storage.copy(str.view());
+	}
+
+	// whether key parsing is enabled at the beginning of parsing
+	bool is_key_parsing_enabled_initially = true;
+
+	bool is_response_files_expansion_enabled = false;
+
+	bool are_key_abbreviations_enabled = false;
 
-	bool is_key_parsing_enabled = true;
+	// handlers as given to add()
+	struct argument_handlers {
+		value_handler_type value_handler;
+		boolean_handler_type boolean_handler;
+
+		// binding of the value to a variable, used instead of the handlers
+		value_binding binding;
+	};
 
 	struct argument_callbacks {
-		std::function<void(std::string_view)> value_handler;
-		std::function<void()> boolean_handler;
+		// single handler slot, the value handler is stored in case the argument accepts value,
+		// otherwise the boolean handler
+		std::variant<std::monostate, value_handler_type, boolean_handler_type> handler;
+
+		// handler of the optional value argument given without value,
+		// such arguments are rare, so it is kept in the arena instead of having a second slot in every argument
+		arena::pointer<boolean_handler_type> default_handler;
+
+		// binding of the value to a variable, used instead of the handlers
+		value_binding binding;
+
+		// see token::id
+		size_t id = npos;
+
+		// index in the collectors, npos in case the argument does not collect its values to a vector
+		size_t collector_index = npos;
+
+		bool accepts_value() const noexcept
+		{
+			return std::holds_alternative<value_handler_type>(this->handler) || this->binding;
+		}
+
+		bool accepts_no_value() const noexcept
+		{
+			return std::holds_alternative<boolean_handler_type>(this->handler) || this->default_handler ||
+				this->binding.implicit_value;
+		}
 	};
 
-	std::map<std::string, argument_callbacks, std::less<>> arguments;
+	// indexed by argument id
+	std::vector<arena::pointer<argument_callbacks>> arguments;
+
+	// flat lookup table of the long keys, used for all parse time lookups
+	lookup_table<const argument_callbacks> arguments_table;
+
+	// prefix tree of the long keys, also used for looking up the keys similar to unknown ones,
+	// accessed with std::atomic_load() and std::atomic_store(), so that the tree can be built on first use
+	mutable std::shared_ptr<const key_trie<const argument_callbacks>> cached_key_trie;
+
+	std::shared_ptr<const key_trie<const argument_callbacks>> get_key_trie() const;
 
-	std::unordered_map<char, std::string_view> short_to_long_map;
+	// looks up the argument by unambiguous prefix of its long key, among the arguments of this and the parent parsers,
+	// in case the prefix is ambiguous, returns nullptr and the matching keys are added to the candidates
+	const argument_callbacks* find_abbreviated_argument(
+		std::string_view prefix, //
+		std::vector<std::string>& candidates
+	) const;
+
+	bool frozen = false;
+
+	void throw_if_frozen() const;
+
+	const argument_callbacks* find_argument(std::string_view key) const;
 
+	const argument_callbacks* find_argument(char short_key) const noexcept
+	{
+		auto a = this->short_key_arguments[static_cast<unsigned char>(short_key)];
+		if (!a && this->parent) {
+			return this->parent->find_argument(short_key);
+		}
+		return a;
+	}
+
+	// short keys are looked up by directly indexing this table with the key character
+	std::array<argument_callbacks*, std::numeric_limits<unsigned char>::max() + 1> short_key_arguments = {};
+
+	// raw data of the argument description, the key names are only formatted when rendering the description
 	// TODO: why does lint complain here on macos?
 	// NOLINTNEXTLINE(bugprone-exception-escape)
 	struct key_description {
-		std::string key_names;
-		std::string description;
+		char short_key;
+
+		// empty in case there is no long key
+		std::string_view long_key;
+
+		std::string_view description;
+
+		bool is_boolean;
+		bool is_value_optional;
+
+		void append_key_names(std::string& out) const;
 	};
 
-	std::function<void(std::string_view)> non_key_handler;
+	value_handler_type non_key_handler;
 
-	std::function<void(
-		std::string_view command, //
-		utki::span<std::string_view>
-	)>
-		subcommand_handler;
+	subcommand_handler_type subcommand_handler;
+
+	struct subcommand {
+		subcommand_factory_type factory;
+	};
+
+	std::vector<arena::pointer<subcommand>> subcommands;
+
+	lookup_table<const subcommand> subcommands_table;
+
+	const subcommand* find_subcommand(std::string_view name) const noexcept
+	{
+		return this->subcommands_table.find(name);
+	}
+
+	// parser of the command the sub-parser is created for, its arguments are recognized by the sub-parser
+	const parser* parent = nullptr;
+
+	struct environment_variable {
+		const argument_callbacks& argument;
+
+		// order of adding, the variables added earlier take precedence for the same argument
+		size_t index;
+	};
+
+	std::vector<arena::pointer<environment_variable>> environment_variables;
+
+	lookup_table<const environment_variable> environment_table;
+
+	// paths of the config files, in the order of increasing precedence
+	std::vector<std::string_view> config_files;
+
+	// whether arguments not given in the command line can be taken from the environment or config files
+	bool has_fallback_sources() const noexcept
+	{
+		return this->environment_table.size() != 0 || !this->config_files.empty();
+	}
+
+	bool has_subcommands() const noexcept
+	{
+		return this->subcommand_handler || !this->subcommands.empty();
+	}
 
 	std::vector<key_description> key_descriptions;
 
-	std::string get_long_key_for_short_key(
+	struct description_cache {
+		unsigned keys_width;
+		unsigned width;
+		std::string text;
+	};
+
+	// rendered description, accessed with std::atomic_load() and std::atomic_store(),
+	// so that description() can be called for a frozen parser from several threads
+	mutable std::shared_ptr<const description_cache> cached_description;
+
+	std::shared_ptr<const description_cache> get_description(
+		unsigned keys_width, //
+		unsigned width
+	) const;
+
+	size_t add_argument(
 		char short_key, //
-		std::string&& long_key
+		string_arg long_key,
+		string_arg description,
+		argument_handlers handlers
 	);
 
-	void push_back_description(
+	// argument collecting its values to a vector
+	struct collector {
+		const argument_callbacks* argument;
+
+		// reserves space for the given number of values in the vector
+		void (*reserve)(void* values, size_t num_values);
+	};
+
+	std::vector<collector> collectors;
+
+	size_t add_collecting_argument(
 		char short_key, //
-		const std::string& long_key,
-		std::string description,
-		bool is_boolean,
-		bool is_value_optional
+		string_arg long_key,
+		string_arg description,
+		value_binding binding,
+		void (*reserve)(void* values, size_t num_values)
 	);
 
-	void add_argument(
-		char short_key, //
-		std::string long_key,
-		std::string description,
-		std::function<void(std::string_view)> value_handler,
-		std::function<void()> boolean_handler
+	// reserves space in the vectors of the collecting arguments for all their occurrences in the args
+	void reserve_collected_values(utki::span<std::string_view> args) const;
+
+	static conversion_result handle_value(
+		const argument_callbacks& argument, //
+		std::string_view value
+	);
+
+	static conversion_result handle_no_value(const argument_callbacks& argument);
+
+	// state of one parse() call
+	struct parse_context;
+
+	// innermost context of ongoing parse() calls of any parser in the calling thread
+	static thread_local parse_context* innermost_parse_context;
+
+	// innermost context of ongoing parse() calls of this parser in the calling thread,
+	// including the parse() calls of its sub-parsers
+	parse_context* find_current_context() const noexcept;
+
+	// parsing errors are reported via the context, exceptions thrown by handlers are let through
+	void parse_arguments(parse_context& context) const;
+
+	// in case with_stats is false, the stats is not used and all the statistics collection is compiled out
+	template <bool with_stats>
+	void parse_arguments(
+		parse_context& context, //
+		parse_stats* stats
+	) const;
+
+	// number of entries examined in the lookup tables when looking up the long key
+	size_t count_probes(std::string_view key) const noexcept;
+
+	// handles arguments not given in the command line, from the environment variables and the config files
+	void handle_fallback_sources(parse_context& context) const;
+
+	// handles arguments of the environment variables, except the ones given in the command line
+	void handle_environment_variables(parse_context& context) const;
+
+	// handles arguments of the config files, except the ones given in the command line or the environment
+	void handle_config_files(parse_context& context) const;
+
+	// handles value of an argument taken from the environment or a config file
+	static void handle_fallback_value(
+		token_range& reader, //
+		const argument_callbacks& argument,
+		bool has_value,
+		std::string_view value
+	);
+};
+
+/**
+ * @brief Range of command line tokens.
+ * See parser::tokens().
+ * The tokens are read lazily, one token per iterator increment.
+ */
+class parser::token_range
+{
+	friend class parser;
+
+	const parser& owner;
+
+	utki::span<std::string_view> args;
+	size_t index = 0;
+
+	// in case of parsing a command line string, arguments are read from the command line instead of the args,
+	// the index is then the number of arguments read
+	tokenizer* command_line = nullptr;
+
+	// in case of parsing a NUL-separated buffer, arguments are read from the rest of the buffer instead of the args,
+	// the index is then the number of arguments read
+	bool is_nul_separated = false;
+	std::string_view nul_separated_args;
+
+	// in case of parsing a stream, arguments are read from the stream instead of the args,
+	// the index is then the number of arguments read
+	stream_reader* stream = nullptr;
+
+	// last argument read from the args or the command line, i.e. not from a response file
+	std::string_view last_arg;
+
+	bool is_key_parsing_enabled;
+	bool is_started = false;
+	bool is_finished = false;
+
+	// whether to look for the keys similar to the unknown ones, only done for the errors which are thrown
+	bool is_suggesting_similar_keys = false;
+
+	// whether the 'current' token is valid, used by the iterators
+	bool has_current = false;
+
+	// short keys batch argument being read and position of its next key
+	std::string_view batch;
+	size_t batch_pos = 0;
+
+	token current;
+
+	// argument of the current key token
+	const argument_callbacks* current_argument = nullptr;
+
+	// location of the current key token value, for error reporting
+	std::string_view current_arg;
+	std::string_view current_key;
+	size_t current_value_offset = 0;
+
+	parse_error error_info;
+
+	// response files are kept mapped until the range is destroyed
+	struct response_files_state;
+
+	// allocated when the first response file is encountered
+	std::unique_ptr<response_files_state> response_files;
+
+	token_range(
+		const parser& owner, //
+		utki::span<std::string_view> args
 	);
 
-	void parse_long_key_argument(std::string_view arg);
+	bool read(std::string_view& arg);
+
+	void push_response_file(std::string_view arg);
+
+	bool read_long_key(
+		std::string_view arg, //
+		token& t
+	);
+
+	bool read_batch_key(token& t);
+
+	void fail(
+		error_code code, //
+		std::string_view argument,
+		size_t offset,
+		std::string_view key = {},
+		std::string_view value = {}
+	);
+
+	// reports conversion error of the current key token value, if any
+	void check(
+		conversion_result result, //
+		std::string_view value
+	);
+
+	bool is_reading_response_file() const noexcept;
+
+public:
+	token_range(const token_range&) = delete;
+	token_range& operator=(const token_range&) = delete;
 
-	// returns pointer to last argument's value handler in case value is the next argument.
-	// returns nullptr otherwise.
-	std::function<void(std::string_view)>* parse_short_keys_batch(std::string_view arg);
+	token_range(token_range&&) = delete;
+	token_range& operator=(token_range&&) = delete;
+
+	~token_range();
+
+	/**
+	 * @brief Read next token.
+	 * @param t - where to store the token.
+	 * @return true if the next token was read.
+	 * @return false if there are no more tokens or an error has occurred, see error().
+	 */
+	bool next(token& t);
+
+	/**
+	 * @brief Enable or disable key arguments parsing.
+	 * Affects the tokens read after the call, see parser::set_key_parsing().
+	 * @param enable - if true, key arguments parsing will be enabled, otherwise - disabled.
+	 */
+	void set_key_parsing(bool enable) noexcept
+	{
+		this->is_key_parsing_enabled = enable;
+	}
+
+	/**
+	 * @brief Get error which has stopped reading the tokens.
+	 * @return the error, evaluates to false in case there was no error.
+	 */
+	const parse_error& error() const noexcept
+	{
+		return this->error_info;
+	}
+
+	/**
+	 * @brief Get the arguments which are not read yet.
+	 * Typically, it is called after the subcommand token to get the arguments of the subcommand.
+	 * No more tokens are read after the call.
+	 * @return the arguments which are not read yet.
+	 */
+	utki::span<std::string_view> remaining();
+
+	class iterator
+	{
+		friend class token_range;
+
+		token_range* range = nullptr;
+
+		explicit iterator(token_range* range) :
+			range(range)
+		{}
+
+		bool is_end() const noexcept
+		{
+			return !this->range || !this->range->has_current;
+		}
+
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = token;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const token*;
+		using reference = const token&;
+
+		iterator() = default;
+
+		const token& operator*() const noexcept
+		{
+			return this->range->current;
+		}
+
+		const token* operator->() const noexcept
+		{
+			return &this->range->current;
+		}
+
+		iterator& operator++()
+		{
+			this->range->has_current = this->range->next(this->range->current);
+			return *this;
+		}
+
+		bool operator==(const iterator& i) const noexcept
+		{
+			return this->is_end() == i.is_end();
+		}
+
+		bool operator!=(const iterator& i) const noexcept
+		{
+			return !this->operator==(i);
+		}
+	};
+
+	/**
+	 * @brief Get iterator to the first token.
+	 * Reads the first token, in case it is not read yet.
+	 * @return iterator to the first token.
+	 */
+	iterator begin()
+	{
+		if (!this->is_started) {
+			this->has_current = this->next(this->current);
+		}
+		return iterator(this);
+	}
+
+	/**
+	 * @brief Get end iterator.
+	 * @return end iterator.
+	 */
+	iterator end() noexcept
+	{
+		return iterator();
+	}
 };
 
 } // namespace clargs
@@ -0,0 +1,552 @@
+/*
+MIT License
+
+Copyright (c) 2018-2023 Ivan Gagis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <utki/debug.hpp>
+#include <utki/span.hpp>
+
+#include "value_kind.hpp"
+
+namespace clargs {
+
+/**
+ * @brief Compile-time description of a key argument.
+ * Short key of '\0' means the argument has no short key.
+ * Empty long key means the argument has no long key, unless short key is also '\0',
+ * in which case it is an argument overriding the '--' handling, like with clargs::parser.
+ */
+struct option {
+	char short_key = '\0';
+	std::string_view long_key;
+	std::string_view description;
+	value_kind value = value_kind::none;
+};
+
+/**
+ * @brief Parser with compile-time specification of the key arguments.
+ * This is an alternative to clargs::parser for the case when the set of key arguments is known at compile time.
+ * The parser is constructed from a constexpr array of clargs::option descriptions, and all the lookup tables
+ * are built at compile time, so constructing the parser does not allocate memory and does not do any work at run time.
+ * Short keys are dispatched via a 256-entry table indexed by the key character, long keys are looked up
+ * with binary search in a compile-time sorted array.
+ * Parsing follows the same rules as clargs::parser, except that subcommands are not supported.
+ * Instead of per-argument callbacks, a single handler is called with the index of the matched option,
+ * so that the user code can dispatch with a switch statement.
+ *
+ * Example:
+ * @code{.cpp}
+ * constexpr std::array<clargs::option, 2> options = {{
+ *     {'v', "verbose", "print more output"},
+ *     {'o', "output", "output file name", clargs::value_kind::required}
+ * }};
+ *
+ * constexpr clargs::static_parser parser(options);
+ *
+ * parser.parse(
+ *     argc,
+ *     argv,
+ *     [&](size_t index, std::optional<std::string_view> value){
+ *         switch(index){
+ *             case 0: verbose = true; break;
+ *             case 1: output = *value; break;
+ *         }
+ *     },
+ *     [&](std::string_view non_key){ files.push_back(non_key); }
+ * );
+ * @endcode
+ *
+ * @tparam num_options - number of options.
+ */
+template <size_t num_options>
+class static_parser
+{
+	static_assert(num_options < std::numeric_limits<uint16_t>::max(), "too many options");
+
+	std::array<option, num_options> options;
+
+	// index of an option plus one, 0 means no option for the short key
+	std::array<uint16_t, std::numeric_limits<unsigned char>::max() + 1> short_keys = {};
+
+	// indices of options having long key, sorted by the long key
+	std::array<uint16_t, num_options> sorted_long_keys = {};
+	size_t num_long_keys = 0;
+
+	constexpr static bool has_long_key(const option& o) noexcept
+	{
+		return !o.long_key.empty() || o.short_key == '\0';
+	}
+
+public:
+	constexpr static auto npos = std::numeric_limits<size_t>::max();
+
+	/**
+	 * @brief Constructor.
+	 * Intended to be evaluated at compile time. In case the options contain duplicate keys
+	 * then the compilation fails.
+	 * @param options - array of options descriptions.
+	 */
+	constexpr explicit static_parser(const std::array<option, num_options>& options) :
+		options(options)
+	{
+		for (size_t i = 0; i != num_options; ++i) {
+			const auto& o = options[i];
+
+			if (o.short_key != '\0') {
+				auto& slot = this->short_keys[static_cast<unsigned char>(o.short_key)];
+				if (slot != 0) {
+					throw std::logic_error("static_parser: duplicate short key");
+				}
+				slot = uint16_t(i + 1);
+			} else if (o.value == value_kind::optional && o.long_key.empty()) {
+				throw std::logic_error("static_parser: '--' argument cannot have optional value");
+			}
+
+			if (!has_long_key(o)) {
+				continue;
+			}
+
+			// insertion sort
+			size_t pos = this->num_long_keys;
+			for (; pos != 0; --pos) {
+				const auto& prev = options[this->sorted_long_keys[pos - 1]];
+				if (prev.long_key == o.long_key) {
+					throw std::logic_error("static_parser: duplicate long key");
+				}
+				if (prev.long_key < o.long_key) {
+					break;
+				}
+				this->sorted_long_keys[pos] = this->sorted_long_keys[pos - 1];
+			}
+			this->sorted_long_keys[pos] = uint16_t(i);
+			++this->num_long_keys;
+		}
+	}
+
+	/**
+	 * @brief Get options.
+	 * @return array of options descriptions the parser was constructed from.
+	 */
+	constexpr const std::array<option, num_options>& get_options() const noexcept
+	{
+		return this->options;
+	}
+
+	/**
+	 * @brief Find option by short key.
+	 * @param short_key - short key to look up.
+	 * @return index of the found option.
+	 * @return npos if there is no option with the given short key.
+	 */
+	constexpr size_t find(char short_key) const noexcept
+	{
+		return size_t(this->short_keys[static_cast<unsigned char>(short_key)]) - 1;
+	}
+
+	/**
+	 * @brief Find option by long key.
+	 * @param long_key - long key to look up.
+	 * @return index of the found option.
+	 * @return npos if there is no option with the given long key.
+	 */
+	constexpr size_t find(std::string_view long_key) const noexcept
+	{
+		size_t begin = 0;
+		size_t end = this->num_long_keys;
+		while (begin != end) {
+			size_t middle = begin + (end - begin) / 2;
+			auto index = this->sorted_long_keys[middle];
+			auto cmp = this->options[index].long_key.compare(long_key);
+			if (cmp == 0) {
+				return index;
+			}
+			if (cmp < 0) {
+				begin = middle + 1;
+			} else {
+				end = middle;
+			}
+		}
+		return npos;
+	}
+
+	/**
+	 * @brief Parse command line arguments.
+	 * Does not allocate memory, unless an error is encountered.
+	 * @param args - array of command line arguments, NOT including the executable filename as first item.
+	 * @param option_handler - callback called for each encountered key argument.
+	 *        Signature is void(size_t index, std::optional<std::string_view> value),
+	 *        where index is the option index in the options array and value is the value of the argument
+	 *        if it has one.
+	 * @param non_key_handler - callback called for each non-key argument.
+	 *        Signature is void(std::string_view argument).
+	 * @throw std::invalid_argument - in case of unknown key argument or malformed key argument.
+	 */
+	template <typename option_handler_type, typename non_key_handler_type>
+	void parse(
+		utki::span<const std::string_view> args, //
+		option_handler_type&& option_handler,
+		non_key_handler_type&& non_key_handler
+	) const
+	{
+		this->parse_arguments(args, option_handler, non_key_handler);
+	}
+
+	/**
+	 * @brief Parse command line arguments.
+	 * Does not allocate memory, unless an error is encountered.
+	 * @param args - array of command line arguments, NOT including the executable filename as first item.
+	 * @param option_handler - callback called for each encountered key argument.
+	 * @param non_key_handler - callback called for each non-key argument.
+	 * @throw std::invalid_argument - in case of unknown key argument or malformed key argument.
+	 */
+	template <typename option_handler_type, typename non_key_handler_type>
+	void parse(
+		utki::span<const char* const> args, //
+		option_handler_type&& option_handler,
+		non_key_handler_type&& non_key_handler
+	) const
+	{
+		this->parse_arguments(args, option_handler, non_key_handler);
+	}
+
+	/**
+	 * @brief Parse command line arguments.
+	 * Parses the command line arguments as they passed in to main() function.
+	 * @param argc - number of arguments.
+	 * @param argv - array of arguments, first item is the executable filename.
+	 * @param option_handler - callback called for each encountered key argument.
+	 * @param non_key_handler - callback called for each non-key argument.
+	 * @throw std::invalid_argument - in case of unknown key argument or malformed key argument.
+	 */
+	template <typename option_handler_type, typename non_key_handler_type>
+	void parse(
+		int argc, //
+		const char* const* argv,
+		option_handler_type&& option_handler,
+		non_key_handler_type&& non_key_handler
+	) const
+	{
+		ASSERT(argc >= 1)
+		this->parse(utki::make_span(argv, argc).subspan(1), option_handler, non_key_handler);
+	}
+
+private:
+	[[noreturn]] static void throw_error(
+		std::string_view message_prefix, //
+		std::string_view arg,
+		std::string_view message_suffix = std::string_view()
+	)
+	{
+		std::string message(message_prefix);
+		message.append(arg);
+		message.append(message_suffix);
+		throw std::invalid_argument(message);
+	}
+
+	template <typename element_type, typename option_handler_type, typename non_key_handler_type>
+	void parse_arguments(
+		utki::span<element_type> args, //
+		option_handler_type& option_handler,
+		non_key_handler_type& non_key_handler
+	) const
+	{
+		constexpr std::string_view long_key_prefix = "--";
+
+		bool is_key_parsing_enabled = true;
+
+		for (auto i = args.begin(); i != args.end(); ++i) {
+			std::string_view arg = *i;
+
+			if (is_key_parsing_enabled && arg.substr(0, long_key_prefix.size()) == long_key_prefix) {
+				auto equals_pos = arg.find('=');
+				auto key = arg.substr(
+					long_key_prefix.size(),
+					equals_pos == std::string_view::npos ? std::string_view::npos : equals_pos - long_key_prefix.size()
+				);
+
+				auto index = this->find(key);
+				if (index == npos) {
+					if (arg.size() == long_key_prefix.size()) {
+						// default handling of '--' argument is disabling key arguments parsing
+						is_key_parsing_enabled = false;
+						continue;
+					}
+					throw_error("unknown argument: ", arg);
+				}
+
+				const auto& o = this->options[index];
+				if (equals_pos != std::string_view::npos) {
+					if (o.value == value_kind::none) {
+						throw_error("key argument '", key, "' is a boolean argument and cannot have value");
+					}
+					option_handler(index, std::optional<std::string_view>(arg.substr(equals_pos + 1)));
+				} else {
+					if (o.value == value_kind::required) {
+						throw_error("key argument '", key, "' requires value");
+					}
+					option_handler(index, std::optional<std::string_view>());
+				}
+			} else if (is_key_parsing_enabled && arg.size() >= 2 && arg[0] == '-') {
+				for (size_t j = 1; j != arg.size(); ++j) {
+					auto index = this->find(arg[j]);
+					if (index == npos) {
+						throw_error("unknown argument: ", arg);
+					}
+
+					if (this->options[index].value != value_kind::required) {
+						option_handler(index, std::optional<std::string_view>());
+						continue;
+					}
+
+					++j;
+					if (j != arg.size()) {
+						option_handler(index, std::optional<std::string_view>(arg.substr(j)));
+						break;
+					}
+
+					// value is the next argument
+					++i;
+					if (i == args.end()) {
+						throw_error("argument '", arg.substr(j - 1, 1), "' requires value");
+					}
+					option_handler(index, std::optional<std::string_view>(*i));
+					break;
+				}
+			} else {
+				non_key_handler(arg);
+			}
+		}
+	}
+};
+
+namespace internal {
+
+// sink which only counts the number of characters written
+struct counting_sink {
+	size_t size = 0;
+
+	constexpr void put(char) noexcept
+	{
+		++this->size;
+	}
+};
+
+template <size_t size>
+struct array_sink {
+	std::array<char, size> buffer = {};
+	size_t pos = 0;
+
+	constexpr void put(char c) noexcept
+	{
+		this->buffer[this->pos] = c;
+		++this->pos;
+	}
+};
+
+template <typename sink_type>
+constexpr void put(
+	sink_type& sink, //
+	std::string_view str
+)
+{
+	for (auto c : str) {
+		sink.put(c);
+	}
+}
+
+template <typename sink_type>
+constexpr void put(
+	sink_type& sink, //
+	char c,
+	size_t num
+)
+{
+	for (size_t i = 0; i != num; ++i) {
+		sink.put(c);
+	}
+}
+
+template <typename sink_type>
+constexpr size_t write_key_names(
+	sink_type& sink, //
+	const option& o
+)
+{
+	// same format as clargs::parser::description()
+	size_t size = 0;
+	auto out = [&](std::string_view str) {
+		put(sink, str);
+		size += str.size();
+	};
+
+	out("  ");
+
+	if (o.short_key != '\0') {
+		out("-");
+		sink.put(o.short_key);
+		++size;
+		if (o.value != value_kind::none && o.long_key.empty()) {
+			out(" VALUE");
+		}
+	}
+
+	if (!o.long_key.empty()) {
+		if (o.short_key != '\0') {
+			out(", ");
+		} else {
+			out("    ");
+		}
+
+		out("--");
+		out(o.long_key);
+		if (o.value == value_kind::optional) {
+			out("[=VALUE]");
+		} else if (o.value == value_kind::required) {
+			out("=VALUE");
+		}
+	}
+
+	return size;
+}
+
+// greedy word wrapping, lines are kept shorter than width, except the lines of single words longer than that,
+// each word goes to a separate line in case the width is 0,
+// also used by clargs::parser::description(), so that the compile time and the runtime descriptions are the same
+template <typename sink_type>
+constexpr void write_wrapped(
+	sink_type& sink, //
+	std::string_view text,
+	size_t width,
+	size_t indentation
+)
+{
+	size_t line_size = 0;
+	bool is_first_line = true;
+
+	auto new_line = [&]() {
+		sink.put('\n');
+		put(sink, ' ', indentation);
+		line_size = 0;
+		is_first_line = false;
+	};
+
+	size_t pos = 0;
+	while (pos != text.size()) {
+		if (text[pos] == '\n') {
+			new_line();
+			++pos;
+			continue;
+		}
+
+		auto end = pos;
+		while (end != text.size() && text[end] != ' ' && text[end] != '\n') {
+			++end;
+		}
+		auto word = text.substr(pos, end - pos);
+
+		if (line_size != 0 && line_size + 1 + word.size() >= width) {
+			new_line();
+		}
+		if (line_size != 0) {
+			sink.put(' ');
+			++line_size;
+		}
+		put(sink, word);
+		line_size += word.size();
+
+		pos = end;
+		if (pos != text.size() && text[pos] == ' ') {
+			++pos;
+		}
+	}
+	sink.put('\n');
+}
+
+template <typename sink_type, size_t num_options>
+constexpr void write_description(
+	sink_type& sink, //
+	const std::array<option, num_options>& options,
+	size_t keys_width,
+	size_t width
+)
+{
+	for (const auto& o : options) {
+		auto size = write_key_names(sink, o);
+
+		if (size > keys_width) {
+			sink.put('\n');
+			put(sink, ' ', keys_width + 2);
+		} else {
+			put(sink, ' ', keys_width - size + 2);
+		}
+
+		write_wrapped(sink, o.description, width, keys_width + 2);
+	}
+}
+
+template <const auto& options, unsigned keys_width, unsigned width>
+constexpr size_t description_size()
+{
+	counting_sink sink;
+	write_description(sink, options, keys_width, width);
+	return sink.size;
+}
+
+} // namespace internal
+
+/**
+ * @brief Get description of the arguments at compile time.
+ * The description has the same format as the one returned by clargs::parser::description().
+ * Usage:
+ * @code{.cpp}
+ * constexpr auto help = clargs::make_description<options>();
+ * std::cout << std::string_view(help.data(), help.size());
+ * @endcode
+ * @tparam options - constexpr array of options descriptions, must have static storage duration.
+ * @tparam keys_width - width in characters of the key names area.
+ * @tparam width - width in characters of key description area.
+ * @return Formatted description of all the arguments, not null-terminated.
+ */
+template <
+	const auto& options, //
+	unsigned keys_width = 28,
+	unsigned width = 50>
+constexpr auto make_description()
+{
+	internal::array_sink<internal::description_size<options, keys_width, width>()> sink;
+	internal::write_description(sink, options, keys_width, width);
+	return sink.buffer;
+}
+
+} // namespace clargs
@@ -0,0 +1,129 @@
+/*
+MIT License
+
+Copyright (c) 2018-2023 Ivan Gagis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace clargs {
+
+/**
+ * @brief String which outlives the parser.
+ * Wraps a view of a string which is known to stay alive at least as long as the parser it is registered to,
+ * typically a string literal. Keys and descriptions given as static_string are not copied by the parser,
+ * only the view is stored.
+ * @code{.cpp}
+ * using namespace clargs::literals;
+ *
+ * clargs::parser p;
+ * p.add('v', "verbose"_static, "print more output"_static, [](){ ... });
+ * @endcode
+ */
+class static_string
+{
+	std::string_view str;
+
+public:
+	/**
+	 * @brief Constructor.
+	 * @param str - the string, must outlive the parser.
+	 */
+	constexpr explicit static_string(std::string_view str) noexcept :
+		str(str)
+	{}
+
+	constexpr std::string_view view() const noexcept
+	{
+		return this->str;
+	}
+};
+
+inline namespace literals {
+
+/**
+ * @brief Make static_string from a string literal.
+ * @param str - string literal.
+ * @param size - length of the string literal.
+ * @return static_string referring to the string literal.
+ */
+constexpr static_string operator""_static(const char* str, size_t size) noexcept
+{
+	return static_string(std::string_view(str, size));
+}
+
+} // namespace literals
+
+/**
+ * @brief String argument of the parser registration functions.
+ * Ordinary strings are copied by the parser, static_string is only referred to.
+ */
+class string_arg
+{
+	std::string_view str;
+	bool is_static_string = false;
+
+public:
+	// the constructors are implicit, so that strings can be passed to the registration functions as is
+
+	// NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
+	constexpr string_arg(const char* str) noexcept :
+		str(str)
+	{}
+
+	// NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
+	string_arg(const std::string& str) noexcept :
+		str(str)
+	{}
+
+	// NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
+	constexpr string_arg(std::string_view str) noexcept :
+		str(str)
+	{}
+
+	// NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
+	constexpr string_arg(static_string str) noexcept :
+		str(str.view()),
+		is_static_string(true)
+	{}
+
+	constexpr std::string_view view() const noexcept
+	{
+		return this->str;
+	}
+
+	/**
+	 * @brief Check if the string outlives the parser.
+	 * @return true in case the string was given as static_string.
+	 * @return false otherwise.
+	 */
+	constexpr bool is_static() const noexcept
+	{
+		return this->is_static_string;
+	}
+};
+
+} // namespace clargs
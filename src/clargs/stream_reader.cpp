@@ -0,0 +1,143 @@
+/*
+MIT License
+
+Copyright (c) 2018-2023 Ivan Gagis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+#include "stream_reader.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+#include <utki/config.hpp>
+#include <utki/debug.hpp>
+
+#if CFG_OS == CFG_OS_WINDOWS
+#	include <io.h>
+#else
+#	include <unistd.h>
+#endif
+
+using namespace clargs;
+
+stream_reader::stream_reader(
+	std::istream& input, //
+	char delimiter,
+	size_t buffer_size
+) :
+	input(&input),
+	delimiter(delimiter),
+	buffer(buffer_size == 0 ? 1 : buffer_size)
+{}
+
+stream_reader::stream_reader(
+	int fd, //
+	char delimiter,
+	size_t buffer_size
+) :
+	fd(fd),
+	delimiter(delimiter),
+	buffer(buffer_size == 0 ? 1 : buffer_size)
+{}
+
+size_t stream_reader::read(
+	char* buf, //
+	size_t size
+)
+{
+	if (this->input) {
+		this->input->read(buf, std::streamsize(size));
+		if (this->input->bad()) {
+			throw std::system_error(std::make_error_code(std::io_errc::stream), "could not read from input stream");
+		}
+		return size_t(this->input->gcount());
+	}
+
+	for (;;) {
+#if CFG_OS == CFG_OS_WINDOWS
+		auto res = _read(this->fd, buf, unsigned(size));
+#else
+		auto res = ::read(this->fd, buf, size);
+#endif
+		if (res >= 0) {
+			return size_t(res);
+		}
+		if (errno != EINTR) {
+			throw std::system_error(errno, std::generic_category(), "could not read from file descriptor");
+		}
+	}
+}
+
+bool stream_reader::next(std::string_view& arg)
+{
+	for (;;) {
+		ASSERT(this->begin <= this->scanned)
+		ASSERT(this->scanned <= this->end)
+
+		auto data = this->buffer.data();
+
+		auto delimiter_ptr = static_cast<const char*>(
+			std::memchr(data + this->scanned, this->delimiter, this->end - this->scanned)
+		);
+		if (delimiter_ptr) {
+			auto pos = size_t(delimiter_ptr - data);
+			arg = std::string_view(data + this->begin, pos - this->begin);
+			this->begin = pos + 1;
+			this->scanned = this->begin;
+			return true;
+		}
+		this->scanned = this->end;
+
+		if (this->is_end_of_input) {
+			if (this->begin == this->end) {
+				return false;
+			}
+			// last argument is not terminated
+			arg = std::string_view(data + this->begin, this->end - this->begin);
+			this->begin = this->end;
+			this->scanned = this->end;
+			return true;
+		}
+
+		// move the incomplete argument to the beginning of the buffer and read more data after it
+		if (this->begin != 0) {
+			std::memmove(data, data + this->begin, this->end - this->begin);
+			this->end -= this->begin;
+			this->scanned = this->end;
+			this->begin = 0;
+		}
+
+		if (this->end == this->buffer.size()) {
+			// the argument does not fit into the buffer
+			this->buffer.resize(this->buffer.size() * 2);
+			data = this->buffer.data();
+		}
+
+		auto num_read = this->read(data + this->end, this->buffer.size() - this->end);
+		if (num_read == 0) {
+			this->is_end_of_input = true;
+		}
+		this->end += num_read;
+	}
+}
@@ -0,0 +1,118 @@
+/*
+MIT License
+
+Copyright (c) 2018-2023 Ivan Gagis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+#pragma once
+
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace clargs {
+
+/**
+ * @brief Reader of delimited arguments from a stream.
+ * Reads arguments separated by a delimiter character from an std::istream or from a file descriptor
+ * into a reusable buffer. The buffer only grows in case a single argument does not fit into it,
+ * so memory consumption does not depend on the number of arguments.
+ */
+class stream_reader
+{
+	std::istream* input = nullptr;
+	int fd = -1;
+
+	char delimiter;
+
+	std::vector<char> buffer;
+
+	// start of the data not returned yet
+	size_t begin = 0;
+
+	// position up to which the data is known to have no delimiter
+	size_t scanned = 0;
+
+	// end of the data read into the buffer
+	size_t end = 0;
+
+	bool is_end_of_input = false;
+
+	// copy of the argument which has to stay valid while reading the next one
+	std::string pinned;
+
+	size_t read(
+		char* buf, //
+		size_t size
+	);
+
+public:
+	/**
+	 * @brief Constructor.
+	 * @param input - stream to read arguments from.
+	 * @param delimiter - arguments delimiter character.
+	 * @param buffer_size - initial size of the buffer.
+	 */
+	stream_reader(
+		std::istream& input, //
+		char delimiter,
+		size_t buffer_size
+	);
+
+	/**
+	 * @brief Constructor.
+	 * @param fd - file descriptor to read arguments from.
+	 * @param delimiter - arguments delimiter character.
+	 * @param buffer_size - initial size of the buffer.
+	 */
+	stream_reader(
+		int fd, //
+		char delimiter,
+		size_t buffer_size
+	);
+
+	/**
+	 * @brief Get next argument.
+	 * The last argument does not need to be terminated by the delimiter.
+	 * @param arg - where to store the view of the next argument. The view is valid until the next call.
+	 * @return true if next argument was read.
+	 * @return false if the end of input is reached.
+	 * @throw std::system_error - in case of reading error.
+	 */
+	bool next(std::string_view& arg);
+
+	/**
+	 * @brief Make copy of the argument which stays valid while reading the next argument.
+	 * Only one argument can be pinned at a time.
+	 * @param arg - argument to copy.
+	 * @return view of the copy, valid until the next pin() call.
+	 */
+	std::string_view pin(std::string_view arg)
+	{
+		this->pinned = arg;
+		return this->pinned;
+	}
+};
+
+} // namespace clargs
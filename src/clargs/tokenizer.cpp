@@ -0,0 +1,315 @@
+/*
+MIT License
+
+Copyright (c) 2018-2023 Ivan Gagis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+#include "tokenizer.hpp"
+
+#include <cstring>
+
+#if defined(__AVX2__)
+#	include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#	include <emmintrin.h>
+#endif
+
+using namespace clargs;
+
+namespace {
+bool is_space(char c) noexcept
+{
+	switch (c) {
+		case ' ':
+		case '\t':
+		case '\n':
+		case '\r':
+		case '\v':
+		case '\f':
+			return true;
+		default:
+			return false;
+	}
+}
+
+bool is_special(char c) noexcept
+{
+	switch (c) {
+		case '\'':
+		case '"':
+		case '\\':
+			return true;
+		default:
+			return is_space(c);
+	}
+}
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+unsigned count_trailing_zeros(unsigned mask) noexcept
+{
+	ASSERT(mask != 0)
+#	if defined(__GNUC__)
+	return unsigned(__builtin_ctz(mask));
+#	else
+	unsigned ret = 0;
+	for (; (mask & 1) == 0; mask >>= 1) {
+		++ret;
+	}
+	return ret;
+#	endif
+}
+#endif
+
+// finds first whitespace, quote or backslash character
+const char* find_special(
+	const char* p, //
+	const char* end
+) noexcept
+{
+#if defined(__AVX2__)
+	const auto space = _mm256_set1_epi8(' ');
+	const auto single_quote = _mm256_set1_epi8('\'');
+	const auto double_quote = _mm256_set1_epi8('"');
+	const auto backslash = _mm256_set1_epi8('\\');
+
+	// '\t', '\n', '\v', '\f' and '\r' are consecutive from 9 to 13
+	const auto tab = _mm256_set1_epi8('\t');
+	const auto control_spaces_range = _mm256_set1_epi8('\r' - '\t');
+
+	constexpr size_t block_size = sizeof(__m256i);
+	for (; size_t(end - p) >= block_size; p += block_size) {
+		auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+
+		auto m = _mm256_or_si256(
+			_mm256_or_si256(_mm256_cmpeq_epi8(v, space), _mm256_cmpeq_epi8(v, single_quote)),
+			_mm256_or_si256(_mm256_cmpeq_epi8(v, double_quote), _mm256_cmpeq_epi8(v, backslash))
+		);
+
+		// unsigned (v - '\t') <= ('\r' - '\t')
+		auto d = _mm256_sub_epi8(v, tab);
+		m = _mm256_or_si256(m, _mm256_cmpeq_epi8(_mm256_min_epu8(d, control_spaces_range), d));
+
+		auto mask = unsigned(_mm256_movemask_epi8(m));
+		if (mask != 0) {
+			return p + count_trailing_zeros(mask);
+		}
+	}
+#elif defined(__SSE2__) || defined(_M_X64)
+	const auto space = _mm_set1_epi8(' ');
+	const auto single_quote = _mm_set1_epi8('\'');
+	const auto double_quote = _mm_set1_epi8('"');
+	const auto backslash = _mm_set1_epi8('\\');
+
+	// '\t', '\n', '\v', '\f' and '\r' are consecutive from 9 to 13
+	const auto tab = _mm_set1_epi8('\t');
+	const auto control_spaces_range = _mm_set1_epi8('\r' - '\t');
+
+	constexpr size_t block_size = sizeof(__m128i);
+	for (; size_t(end - p) >= block_size; p += block_size) {
+		auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+
+		auto m = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, single_quote)),
+			_mm_or_si128(_mm_cmpeq_epi8(v, double_quote), _mm_cmpeq_epi8(v, backslash))
+		);
+
+		// unsigned (v - '\t') <= ('\r' - '\t')
+		auto d = _mm_sub_epi8(v, tab);
+		m = _mm_or_si128(m, _mm_cmpeq_epi8(_mm_min_epu8(d, control_spaces_range), d));
+
+		auto mask = unsigned(_mm_movemask_epi8(m));
+		if (mask != 0) {
+			return p + count_trailing_zeros(mask);
+		}
+	}
+#endif
+
+	for (; p != end; ++p) {
+		if (is_special(*p)) {
+			break;
+		}
+	}
+	return p;
+}
+
+// finds first double quote or backslash character, i.e. the characters which are special within double quotes
+const char* find_double_quoted_special(
+	const char* p, //
+	const char* end
+) noexcept
+{
+#if defined(__AVX2__)
+	const auto double_quote = _mm256_set1_epi8('"');
+	const auto backslash = _mm256_set1_epi8('\\');
+
+	constexpr size_t block_size = sizeof(__m256i);
+	for (; size_t(end - p) >= block_size; p += block_size) {
+		auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+
+		auto m = _mm256_or_si256(_mm256_cmpeq_epi8(v, double_quote), _mm256_cmpeq_epi8(v, backslash));
+
+		auto mask = unsigned(_mm256_movemask_epi8(m));
+		if (mask != 0) {
+			return p + count_trailing_zeros(mask);
+		}
+	}
+#elif defined(__SSE2__) || defined(_M_X64)
+	const auto double_quote = _mm_set1_epi8('"');
+	const auto backslash = _mm_set1_epi8('\\');
+
+	constexpr size_t block_size = sizeof(__m128i);
+	for (; size_t(end - p) >= block_size; p += block_size) {
+		auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+
+		auto m = _mm_or_si128(_mm_cmpeq_epi8(v, double_quote), _mm_cmpeq_epi8(v, backslash));
+
+		auto mask = unsigned(_mm_movemask_epi8(m));
+		if (mask != 0) {
+			return p + count_trailing_zeros(mask);
+		}
+	}
+#endif
+
+	for (; p != end; ++p) {
+		if (*p == '"' || *p == '\\') {
+			break;
+		}
+	}
+	return p;
+}
+} // namespace
+
+tokenizer::status tokenizer::next(std::string_view& token) noexcept
+{
+	while (this->cur != this->end && is_space(*this->cur)) {
+		++this->cur;
+	}
+
+	if (this->cur == this->end) {
+		return status::end;
+	}
+
+	const char* begin = this->cur;
+
+	this->cur = find_special(this->cur, this->end);
+
+	if (this->cur == this->end || is_space(*this->cur)) {
+		// no quotes or escapes, the argument is taken as is
+		token = std::string_view(begin, this->cur - begin);
+		return status::ok;
+	}
+
+	// unquoted and unescaped characters are written to 'out', which is either in the scratch buffer,
+	// or in the text itself, lagging behind 'cur' once some quote or escape is encountered
+	char* const out_begin = this->scratch ? this->scratch : const_cast<char*>(begin);
+	char* out = out_begin;
+
+	auto put = [&out](const char* from, const char* to) {
+		auto size = size_t(to - from);
+		if (out != from) {
+			std::memmove(out, from, size);
+		}
+		out += size;
+	};
+
+	put(begin, this->cur);
+
+	char quote = '\0';
+
+	while (this->cur != this->end) {
+		char c = *this->cur;
+
+		if (quote == '\'') {
+			auto closing = static_cast<const char*>(std::memchr(this->cur, '\'', this->end - this->cur));
+			if (!closing) {
+				this->cur = this->end;
+				break;
+			}
+			put(this->cur, closing);
+			this->cur = closing + 1;
+			quote = '\0';
+			continue;
+		}
+
+		if (quote == '"') {
+			// copy the run of characters up to the closing quote or the escape at once
+			auto special = find_double_quoted_special(this->cur, this->end);
+			put(this->cur, special);
+			this->cur = special;
+			if (this->cur == this->end) {
+				break;
+			}
+
+			if (*this->cur == '"') {
+				quote = '\0';
+			} else {
+				// backslash only escapes double quote and backslash, otherwise it is taken as is
+				if (this->cur + 1 != this->end && (this->cur[1] == '"' || this->cur[1] == '\\')) {
+					++this->cur;
+				}
+				put(this->cur, this->cur + 1);
+			}
+			++this->cur;
+			continue;
+		}
+
+		if (is_space(c)) {
+			break;
+		}
+
+		switch (c) {
+			case '\'':
+			case '"':
+				quote = c;
+				++this->cur;
+				break;
+			case '\\':
+				if (this->cur + 1 != this->end) {
+					++this->cur;
+				}
+				put(this->cur, this->cur + 1);
+				++this->cur;
+				break;
+			default:
+				{
+					// copy the run of ordinary characters at once
+					auto special = find_special(this->cur, this->end);
+					put(this->cur, special);
+					this->cur = special;
+				}
+				break;
+		}
+	}
+
+	if (quote != '\0') {
+		token = std::string_view(begin, this->end - begin);
+		return status::unterminated_quote;
+	}
+
+	if (this->scratch) {
+		this->scratch = out;
+	}
+
+	token = std::string_view(out_begin, out - out_begin);
+	return status::ok;
+}
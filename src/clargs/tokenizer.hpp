@@ -0,0 +1,110 @@
+/*
+MIT License
+
+Copyright (c) 2018-2023 Ivan Gagis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+#pragma once
+
+#include <string_view>
+
+#include <utki/debug.hpp>
+#include <utki/span.hpp>
+
+namespace clargs {
+
+/**
+ * @brief Splitter of text into command line arguments.
+ * Splits the text into arguments separated by whitespace, following POSIX shell-like quoting rules:
+ * - text in single quotes is taken literally;
+ * - text in double quotes is taken literally, except that backslash escapes '"' and '\\';
+ * - outside of quotes, backslash escapes any following character.
+ *
+ * Arguments which do not have any quotes or escapes are returned as views into the text.
+ * Quotes and escaping backslashes are removed either in place, in case the text buffer is writable,
+ * or into a separate scratch buffer otherwise.
+ * In the in place mode, arguments which do not have any quotes or escapes are not written to,
+ * so for a copy-on-write memory mapping only the pages having those are copied.
+ *
+ * The text is scanned for whitespace, quotes and backslashes with SSE2 or AVX2 instructions,
+ * when those are enabled at compile time.
+ */
+class tokenizer
+{
+	const char* cur;
+	const char* end;
+
+	// where to write unquoted and unescaped arguments, nullptr for in place mode
+	char* scratch = nullptr;
+
+public:
+	/**
+	 * @brief Constructor.
+	 * Creates tokenizer which removes quotes and escapes in place.
+	 * @param text - text to split into arguments. The text buffer must outlive the tokenizer and the returned views.
+	 */
+	explicit tokenizer(utki::span<char> text) :
+		cur(text.data()),
+		end(text.data() + text.size())
+	{}
+
+	/**
+	 * @brief Constructor.
+	 * Creates tokenizer which does not modify the text.
+	 * @param text - text to split into arguments. The text must outlive the tokenizer and the returned views.
+	 * @param scratch - buffer to write arguments having quotes or escapes to. Must be at least of the text size.
+	 *        The buffer must outlive the tokenizer and the returned views.
+	 */
+	tokenizer(
+		std::string_view text, //
+		utki::span<char> scratch
+	) :
+		cur(text.data()),
+		end(text.data() + text.size()),
+		scratch(scratch.data())
+	{
+		ASSERT(scratch.size() >= text.size())
+	}
+
+	/**
+	 * @brief Result of getting next argument.
+	 */
+	enum class status {
+		ok,
+		end,
+		unterminated_quote
+	};
+
+	/**
+	 * @brief Get next argument.
+	 * @param token - where to store the view of the next argument.
+	 *        In case of unterminated quote, the view of the rest of the text starting from the argument
+	 *        beginning is stored, in the in place mode it can be partially unquoted already.
+	 * @return status::ok if next argument was found.
+	 * @return status::end if the end of the text is reached.
+	 * @return status::unterminated_quote if the text ends within a quoted string.
+	 */
+	status next(std::string_view& token) noexcept;
+};
+
+} // namespace clargs
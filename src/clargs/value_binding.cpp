@@ -0,0 +1,110 @@
+/*
+MIT License
+
+Copyright (c) 2018-2023 Ivan Gagis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+#include "value_binding.hpp"
+
+#include <cctype>
+#include <cmath>
+#include <locale>
+#include <sstream>
+
+using namespace clargs;
+
+conversion_result clargs::parse_boolean(std::string_view str, bool& value) noexcept
+{
+	if (str == "true" || str == "yes" || str == "on" || str == "1") {
+		value = true;
+		return conversion_result::ok;
+	}
+	if (str == "false" || str == "no" || str == "off" || str == "0") {
+		value = false;
+		return conversion_result::ok;
+	}
+	return conversion_result::invalid_value;
+}
+
+namespace {
+template <typename value_type>
+conversion_result parse_floating_point_value(std::string_view str, value_type& value) noexcept
+{
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+	auto res = std::from_chars(str.data(), str.data() + str.size(), value);
+	if (res.ec == std::errc::result_out_of_range) {
+		return conversion_result::out_of_range;
+	}
+	if (res.ec != std::errc() || res.ptr != str.data() + str.size()) {
+		return conversion_result::invalid_value;
+	}
+	return conversion_result::ok;
+#else
+	// floating point std::from_chars() is not available, fall back to stream parsing with classic locale
+	if (str.empty() || std::isspace(static_cast<unsigned char>(str.front()))) {
+		return conversion_result::invalid_value;
+	}
+	try {
+		std::istringstream ss{std::string(str)};
+		ss.imbue(std::locale::classic());
+		value_type v{};
+		ss >> v;
+		if (ss.fail()) {
+			return std::isinf(v) || v != 0 ? conversion_result::out_of_range : conversion_result::invalid_value;
+		}
+		if (ss.peek() != std::char_traits<char>::eof()) {
+			return conversion_result::invalid_value;
+		}
+		value = v;
+		return conversion_result::ok;
+	} catch (...) {
+		return conversion_result::invalid_value;
+	}
+#endif
+}
+} // namespace
+
+conversion_result clargs::parse_floating_point(std::string_view str, float& value) noexcept
+{
+	return parse_floating_point_value(str, value);
+}
+
+conversion_result clargs::parse_floating_point(std::string_view str, double& value) noexcept
+{
+	return parse_floating_point_value(str, value);
+}
+
+conversion_result clargs::parse_floating_point(std::string_view str, long double& value) noexcept
+{
+	return parse_floating_point_value(str, value);
+}
+
+conversion_result value_binding::append_view(
+	void* target, //
+	const void* context,
+	std::string_view value
+)
+{
+	static_cast<std::vector<std::string_view>*>(target)->push_back(value);
+	return conversion_result::ok;
+}
@@ -0,0 +1,247 @@
+/*
+MIT License
+
+Copyright (c) 2018-2023 Ivan Gagis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace clargs {
+
+/**
+ * @brief Result of converting argument value string to a typed value.
+ */
+enum class conversion_result {
+	ok,
+	invalid_value,
+	out_of_range
+};
+
+/**
+ * @brief Parse boolean value.
+ * Accepted values are "true", "yes", "on", "1" and "false", "no", "off", "0".
+ * @param str - string to parse.
+ * @param value - where to store the parsed value.
+ * @return result of the conversion.
+ */
+conversion_result parse_boolean(std::string_view str, bool& value) noexcept;
+
+/**
+ * @brief Parse floating point value.
+ * The value is parsed independently of the current locale.
+ * @param str - string to parse.
+ * @param value - where to store the parsed value.
+ * @return result of the conversion.
+ */
+conversion_result parse_floating_point(std::string_view str, float& value) noexcept;
+
+/**
+ * @copydoc parse_floating_point(std::string_view, float&)
+ */
+conversion_result parse_floating_point(std::string_view str, double& value) noexcept;
+
+/**
+ * @copydoc parse_floating_point(std::string_view, float&)
+ */
+conversion_result parse_floating_point(std::string_view str, long double& value) noexcept;
+
+/**
+ * @brief Check if value of the given type can be bound to an argument.
+ * Bindable types are bool, integral types except char, floating point types and std::string.
+ * Enumerations can be bound as well, but that requires a table of enumeration value names.
+ */
+template <typename value_type>
+constexpr bool is_bindable_v = std::is_same_v<value_type, bool> ||
+	(std::is_integral_v<value_type> && !std::is_same_v<value_type, char>) || std::is_floating_point_v<value_type> ||
+	std::is_same_v<value_type, std::string>;
+
+/**
+ * @brief Check if values of the given type can be collected from all occurrences of an argument.
+ * Collectable types are the bindable types and std::string_view.
+ */
+template <typename value_type>
+constexpr bool is_collectable_v = is_bindable_v<value_type> || std::is_same_v<value_type, std::string_view>;
+
+/**
+ * @brief Name to value mapping of an enumeration.
+ */
+template <typename enum_type, size_t num_values>
+using enum_names = std::array<std::pair<std::string_view, enum_type>, num_values>;
+
+/**
+ * @brief Binding of argument value to a variable.
+ * Compact replacement of a value handler callback for the arguments which just store their
+ * converted value to a variable. Holds a pointer to the type specific conversion function, which also serves
+ * as a type tag, a pointer to the target variable and an optional pointer to conversion context,
+ * e.g. table of enumeration value names.
+ */
+struct value_binding {
+	using store_function_type = conversion_result (*)(void* target, const void* context, std::string_view value);
+
+	store_function_type store = nullptr;
+	void* target = nullptr;
+	const void* context = nullptr;
+
+	/**
+	 * @brief Value to store when the argument is given without value.
+	 * If null, then the argument requires value.
+	 */
+	const char* implicit_value = nullptr;
+
+	explicit operator bool() const noexcept
+	{
+		return this->store != nullptr;
+	}
+
+	/**
+	 * @brief Convert and store value to the bound variable.
+	 * @param value - string value to convert.
+	 * @return result of the conversion. In case of conversion failure the variable is not modified.
+	 */
+	conversion_result operator()(std::string_view value) const
+	{
+		return this->store(this->target, this->context, value);
+	}
+
+	template <typename value_type>
+	static conversion_result convert(
+		std::string_view str, //
+		value_type& value
+	)
+	{
+		if constexpr (std::is_same_v<value_type, bool>) {
+			return parse_boolean(str, value);
+		} else if constexpr (std::is_integral_v<value_type>) {
+			auto res = std::from_chars(str.data(), str.data() + str.size(), value);
+			if (res.ec == std::errc::result_out_of_range) {
+				return conversion_result::out_of_range;
+			}
+			if (res.ec != std::errc() || res.ptr != str.data() + str.size()) {
+				return conversion_result::invalid_value;
+			}
+			return conversion_result::ok;
+		} else if constexpr (std::is_floating_point_v<value_type>) {
+			return parse_floating_point(str, value);
+		} else {
+			static_assert(std::is_same_v<value_type, std::string>, "unsupported value type");
+			value = str;
+			return conversion_result::ok;
+		}
+	}
+
+	template <typename value_type>
+	static value_binding make(value_type& target)
+	{
+		static_assert(is_bindable_v<value_type>, "unsupported value type");
+
+		value_binding ret;
+		ret.store = [](void* target, const void* context, std::string_view value) {
+			value_type v{};
+			auto res = convert(value, v);
+			if (res == conversion_result::ok) {
+				*static_cast<value_type*>(target) = std::move(v);
+			}
+			return res;
+		};
+		ret.target = &target;
+
+		if constexpr (std::is_same_v<value_type, bool>) {
+			ret.implicit_value = "true";
+		}
+
+		return ret;
+	}
+
+	/**
+	 * @brief Store function of the std::vector<std::string_view> bindings.
+	 * Appends the value view to the vector, so it also serves as a tag of the bindings
+	 * which require the value to outlive the parsing.
+	 */
+	static conversion_result append_view(
+		void* target, //
+		const void* context,
+		std::string_view value
+	);
+
+	template <typename value_type>
+	static value_binding make(std::vector<value_type>& target)
+	{
+		static_assert(is_collectable_v<value_type>, "unsupported value type");
+
+		value_binding ret;
+		if constexpr (std::is_same_v<value_type, std::string_view>) {
+			ret.store = &append_view;
+		} else {
+			ret.store = [](void* target, const void* context, std::string_view value) {
+				auto& values = *static_cast<std::vector<value_type>*>(target);
+				if constexpr (std::is_same_v<value_type, std::string>) {
+					values.emplace_back(value);
+					return conversion_result::ok;
+				} else {
+					value_type v{};
+					auto res = convert(value, v);
+					if (res == conversion_result::ok) {
+						values.push_back(v);
+					}
+					return res;
+				}
+			};
+		}
+		ret.target = &target;
+		return ret;
+	}
+
+	template <typename enum_type, size_t num_values>
+	static value_binding make(
+		enum_type& target, //
+		const enum_names<enum_type, num_values>& names
+	)
+	{
+		static_assert(std::is_enum_v<enum_type>, "enum_type must be an enumeration");
+
+		value_binding ret;
+		ret.store = [](void* target, const void* context, std::string_view value) {
+			const auto& names = *static_cast<const enum_names<enum_type, num_values>*>(context);
+			for (const auto& n : names) {
+				if (n.first == value) {
+					*static_cast<enum_type*>(target) = n.second;
+					return conversion_result::ok;
+				}
+			}
+			return conversion_result::invalid_value;
+		};
+		ret.target = &target;
+		ret.context = &names;
+		return ret;
+	}
+};
+
+} // namespace clargs
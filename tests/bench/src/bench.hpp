@@ -0,0 +1,81 @@
+#pragma once
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+// Helpers for measuring and reporting benchmark results.
+// Results are printed to stdout one JSON object per line, so that
+// outputs of different runs can be compared with external tools.
+
+namespace bench {
+
+/**
+ * @brief Measure average duration of one operation.
+ * Calls the function repeatedly until the total time exceeds a reasonable minimum.
+ * @param num_ops_per_run - number of operations performed by one call of the function.
+ * @param func - function to measure.
+ * @return average duration of one operation in nanoseconds.
+ */
+template <typename function_type>
+double measure_ns_per_op(
+	size_t num_ops_per_run, //
+	function_type&& func
+)
+{
+	using clock = std::chrono::steady_clock;
+
+	const auto min_duration = std::chrono::milliseconds(200);
+
+	// warm up
+	func();
+
+	size_t num_runs = 0;
+	auto start = clock::now();
+	auto elapsed = clock::duration::zero();
+	do {
+		func();
+		++num_runs;
+		elapsed = clock::now() - start;
+	} while (elapsed < min_duration);
+
+	auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+	return double(ns) / double(num_runs * num_ops_per_run);
+}
+
+/**
+ * @brief Print benchmark result.
+ * @param name - name of the benchmark.
+ * @param n - size parameter of the benchmark.
+ * @param ns_per_op - measured average duration of one operation in nanoseconds.
+ */
+inline void report(
+	std::string_view name, //
+	size_t n,
+	double ns_per_op
+)
+{
+	std::cout << R"({"benchmark":")" << name << R"(","n":)" << n << R"(,"ns_per_op":)" << ns_per_op
+			  << R"(,"ops_per_sec":)" << (ns_per_op > 0 ? 1e9 / ns_per_op : 0) << "}" << std::endl;
+}
+
+inline std::string make_key(size_t i)
+{
+	return "option-number-" + std::to_string(i);
+}
+
+void run_key_lookup();
+void run_parse();
+void run_tokens();
+void run_command_line();
+void run_registration();
+void run_description();
+void run_concurrent_parse();
+void run_subcommands();
+void run_collect();
+void run_environment();
+void run_config_files();
+void run_suggestions();
+
+} // namespace bench
@@ -0,0 +1,68 @@
+#include <string>
+#include <vector>
+
+#include <clargs/parser.hpp>
+
+#include "bench.hpp"
+
+namespace {
+// measures parsing a command line consisting of num_values occurrences of a multi-valued option,
+// with the values collected by a user handler into strings and by the parser into views,
+// an operation is handling one occurrence
+void bench_collect(size_t num_values)
+{
+	std::vector<std::string> strings;
+	strings.reserve(num_values);
+	for (size_t i = 0; i != num_values; ++i) {
+		strings.push_back("/usr/include/directory-number-" + std::to_string(i));
+	}
+
+	std::vector<std::string_view> args;
+	args.reserve(num_values * 2);
+	for (const auto& s : strings) {
+		args.emplace_back("-I");
+		args.emplace_back(s);
+	}
+
+	{
+		std::vector<std::string> includes;
+
+		clargs::parser p;
+		p.add('I', "include directory", [&includes](std::string_view v) {
+			includes.emplace_back(v);
+		});
+		p.freeze();
+
+		auto ns = bench::measure_ns_per_op(num_values, [&]() {
+			includes.clear();
+			includes.shrink_to_fit();
+			p.parse_views(args);
+		});
+
+		bench::report("collect_handler", num_values, ns);
+	}
+
+	{
+		std::vector<std::string_view> includes;
+
+		clargs::parser p;
+		p.add('I', "include directory", includes);
+		p.freeze();
+
+		auto ns = bench::measure_ns_per_op(num_values, [&]() {
+			includes.clear();
+			includes.shrink_to_fit();
+			p.parse_views(args);
+		});
+
+		bench::report("collect_views", num_values, ns);
+	}
+}
+} // namespace
+
+void bench::run_collect()
+{
+	for (size_t n : {100, 10000}) {
+		bench_collect(n);
+	}
+}
@@ -0,0 +1,63 @@
+#include <string>
+
+#include <clargs/parser.hpp>
+
+#include "bench.hpp"
+
+namespace {
+// measures splitting and parsing of a command line given as a single string,
+// the n is the number of bytes in the command line and an operation is parsing of one byte
+void bench_command_line(size_t num_bytes)
+{
+	clargs::parser p;
+
+	size_t counter = 0;
+
+	p.add('v', "verbose", "boolean option", [&counter]() {
+		++counter;
+	});
+	p.add('o', "output", "value option", [&counter](std::string_view v) {
+		counter += v.size();
+	});
+	p.add([&counter](std::string_view v) {
+		counter += v.size();
+	});
+
+	p.freeze();
+
+	std::string command_line;
+	command_line.reserve(num_bytes);
+	for (size_t i = 0; command_line.size() < num_bytes; ++i) {
+		switch (i % 5) {
+			case 0:
+				command_line.append("-v ");
+				break;
+			case 1:
+				command_line.append("--output=some/output/file/path.txt ");
+				break;
+			case 2:
+				command_line.append("'quoted argument with spaces' ");
+				break;
+			case 3:
+				command_line.append("\"double quoted argument with \\\"escaped\\\" quotes\" ");
+				break;
+			default:
+				command_line.append("some/input/file/path/").append(std::to_string(i)).append(".txt\t");
+				break;
+		}
+	}
+
+	auto ns = bench::measure_ns_per_op(command_line.size(), [&]() {
+		p.parse(std::string_view(command_line));
+	});
+
+	bench::report("command_line", num_bytes, ns);
+}
+} // namespace
+
+void bench::run_command_line()
+{
+	for (size_t n : {100, 10'000, 1'000'000, 10'000'000}) {
+		bench_command_line(n);
+	}
+}
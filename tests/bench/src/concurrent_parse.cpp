@@ -0,0 +1,70 @@
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <clargs/parser.hpp>
+
+#include "bench.hpp"
+
+namespace {
+// measures parsing throughput of a frozen parser shared by several threads
+void bench_concurrent_parse(size_t num_threads)
+{
+	clargs::parser p;
+
+	std::atomic<size_t> counter{0};
+
+	constexpr size_t num_options = 100;
+	for (size_t i = 0; i != num_options; ++i) {
+		p.add(bench::make_key(i), "value option", [&counter](std::string_view v) {
+			counter.fetch_add(v.size(), std::memory_order_relaxed);
+		});
+	}
+	p.add('v', "boolean option", []() {});
+
+	p.freeze();
+
+	constexpr size_t num_args = 100;
+
+	std::vector<std::string> storage;
+	storage.reserve(num_args);
+	for (size_t i = 0; i != num_args; ++i) {
+		if (i % 2 == 0) {
+			storage.push_back("--" + bench::make_key(i % num_options) + "=value");
+		} else {
+			storage.emplace_back("-v");
+		}
+	}
+
+	const std::vector<std::string_view> args(storage.begin(), storage.end());
+
+	constexpr size_t num_parses_per_thread = 10'000;
+
+	auto ns = bench::measure_ns_per_op(num_threads * num_parses_per_thread * num_args, [&]() {
+		std::vector<std::thread> threads;
+		for (size_t t = 0; t != num_threads; ++t) {
+			threads.emplace_back([&]() {
+				auto thread_args = args;
+				for (size_t i = 0; i != num_parses_per_thread; ++i) {
+					p.parse_views(thread_args);
+				}
+			});
+		}
+		for (auto& t : threads) {
+			t.join();
+		}
+	});
+
+	// the reported value is the wall clock time per argument of all threads together
+	bench::report("concurrent_parse", num_threads, ns);
+}
+} // namespace
+
+void bench::run_concurrent_parse()
+{
+	auto max_threads = std::max(1u, std::thread::hardware_concurrency());
+	for (size_t n = 1; n <= max_threads; n *= 2) {
+		bench_concurrent_parse(n);
+	}
+}
@@ -0,0 +1,82 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <clargs/parser.hpp>
+
+#include "bench.hpp"
+
+namespace {
+// measures taking num_settings settings from a config file, by translating the file lines
+// to "--key=value" arguments and by the parser's config files support,
+// an operation is handling one setting
+void bench_config_files(size_t num_settings)
+{
+	const std::string path = "clargs_bench_config_file.conf";
+
+	std::vector<std::string> keys;
+	{
+		std::ofstream f(path, std::ios::binary);
+		for (size_t i = 0; i != num_settings; ++i) {
+			keys.push_back("service-setting-number-" + std::to_string(i));
+			f << keys.back() << " = " << i << "\n";
+		}
+	}
+
+	std::vector<int> values(num_settings);
+
+	{
+		clargs::parser p;
+		for (size_t i = 0; i != num_settings; ++i) {
+			p.add(keys[i], "setting", values[i]);
+		}
+		p.freeze();
+
+		auto ns = bench::measure_ns_per_op(num_settings, [&]() {
+			std::ifstream f(path, std::ios::binary);
+
+			std::vector<std::string> args;
+			std::string line;
+			while (std::getline(f, line)) {
+				auto equals_pos = line.find('=');
+				auto key = line.substr(0, line.find_last_not_of(' ', equals_pos - 1) + 1);
+				auto value = line.substr(line.find_first_not_of(' ', equals_pos + 1));
+				args.push_back("--" + key + "=" + value);
+			}
+
+			std::vector<std::string_view> views(args.begin(), args.end());
+			p.parse_views(views);
+		});
+
+		bench::report("config_synthetic_arguments", num_settings, ns);
+	}
+
+	{
+		clargs::parser p;
+		for (size_t i = 0; i != num_settings; ++i) {
+			p.add(keys[i], "setting", values[i]);
+		}
+		p.add_config_file(path);
+		p.freeze();
+
+		std::vector<std::string_view> args;
+
+		auto ns = bench::measure_ns_per_op(num_settings, [&]() {
+			p.parse_views(args);
+		});
+
+		bench::report("config_file", num_settings, ns);
+	}
+
+	std::remove(path.c_str());
+}
+} // namespace
+
+void bench::run_config_files()
+{
+	for (size_t n : {10, 100, 1000}) {
+		bench_config_files(n);
+	}
+}
@@ -0,0 +1,48 @@
+#include <clargs/parser.hpp>
+
+#include "bench.hpp"
+
+namespace {
+// measures cost of getting the cached arguments description and of rendering it
+void bench_description(size_t num_options)
+{
+	clargs::parser p;
+
+	for (size_t i = 0; i != num_options; ++i) {
+		p.add(
+			i < 26 ? char('a' + i) : '\0',
+			bench::make_key(i),
+			"description of the option which is long enough to be wrapped to several lines of the help text",
+			[](std::string_view) {}
+		);
+	}
+
+	auto ns = bench::measure_ns_per_op(num_options, [&]() {
+		auto d = p.description();
+		if (d.empty()) {
+			std::cout << "empty description" << std::endl;
+		}
+	});
+
+	bench::report("description", num_options, ns);
+
+	// alternating widths make the description rendered on every call
+	unsigned keys_width = clargs::parser::default_keys_width;
+	ns = bench::measure_ns_per_op(num_options, [&]() {
+		keys_width ^= 1;
+		auto d = p.description(keys_width);
+		if (d.empty()) {
+			std::cout << "empty description" << std::endl;
+		}
+	});
+
+	bench::report("description_render", num_options, ns);
+}
+} // namespace
+
+void bench::run_description()
+{
+	for (size_t n : {10, 100, 1000}) {
+		bench_description(n);
+	}
+}
@@ -0,0 +1,90 @@
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <utki/config.hpp>
+
+#include <clargs/parser.hpp>
+
+#include "bench.hpp"
+
+namespace {
+#if CFG_OS != CFG_OS_WINDOWS
+// measures taking num_options options from the environment with num_variables unrelated variables in it,
+// by calling getenv() for each option and by the parser's environment variables fallback,
+// an operation is handling one option
+void bench_environment(
+	size_t num_options, //
+	size_t num_variables
+)
+{
+	std::vector<std::string> names;
+	for (size_t i = 0; i != num_options; ++i) {
+		names.push_back("CLARGS_BENCH_OPTION_" + std::to_string(i));
+		setenv(names.back().c_str(), std::to_string(i).c_str(), 1);
+	}
+
+	std::vector<std::string> unrelated_names;
+	for (size_t i = 0; i != num_variables; ++i) {
+		unrelated_names.push_back("CLARGS_BENCH_UNRELATED_" + std::to_string(i));
+		setenv(unrelated_names.back().c_str(), "value", 1);
+	}
+
+	std::vector<int> values(num_options);
+
+	{
+		clargs::parser p;
+		for (size_t i = 0; i != num_options; ++i) {
+			p.add(names[i], "option", values[i]);
+		}
+		p.freeze();
+
+		std::vector<std::string_view> args;
+
+		auto ns = bench::measure_ns_per_op(num_options, [&]() {
+			p.parse_views(args);
+			for (size_t i = 0; i != num_options; ++i) {
+				// the command line did not have the option
+				if (auto v = std::getenv(names[i].c_str())) {
+					values[i] = std::atoi(v);
+				}
+			}
+		});
+
+		bench::report("environment_getenv", num_options, ns);
+	}
+
+	{
+		clargs::parser p;
+		for (size_t i = 0; i != num_options; ++i) {
+			p.add_environment_variable(p.add(names[i], "option", values[i]), names[i]);
+		}
+		p.freeze();
+
+		std::vector<std::string_view> args;
+
+		auto ns = bench::measure_ns_per_op(num_options, [&]() {
+			p.parse_views(args);
+		});
+
+		bench::report("environment_fallback", num_options, ns);
+	}
+
+	for (const auto& n : names) {
+		unsetenv(n.c_str());
+	}
+	for (const auto& n : unrelated_names) {
+		unsetenv(n.c_str());
+	}
+}
+#endif
+} // namespace
+
+void bench::run_environment()
+{
+#if CFG_OS != CFG_OS_WINDOWS
+	for (size_t n : {10, 100, 1000}) {
+		bench_environment(n, 100);
+	}
+#endif
+}
@@ -0,0 +1,90 @@
+#include <vector>
+
+#include <clargs/parser.hpp>
+
+#include "bench.hpp"
+
+namespace {
+enum class lookup_mode {
+	exact,
+
+	// exact keys with long key abbreviations enabled, to check that exact lookups do not get slower
+	exact_with_abbreviations,
+
+	// keys abbreviated by omitting their unique suffixes
+	abbreviated
+};
+
+// measures the cost of looking up a key argument in a parser with many registered arguments
+void bench_key_lookup(
+	size_t num_options, //
+	lookup_mode mode
+)
+{
+	// suffix of the registered keys which is omitted in the command line in case of abbreviated lookups
+	const std::string suffix = mode == lookup_mode::abbreviated ? "-suffix" : "";
+
+	// unique prefix of the suffix, so that the abbreviated keys are unambiguous
+	const std::string abbreviated_suffix = suffix.substr(0, 1);
+
+	clargs::parser p;
+	p.set_key_abbreviations(mode != lookup_mode::exact);
+
+	size_t counter = 0;
+
+	for (size_t i = 0; i != num_options; ++i) {
+		if (i % 2 == 0) {
+			p.add(bench::make_key(i) + suffix, "boolean option", [&counter]() {
+				++counter;
+			});
+		} else {
+			p.add(bench::make_key(i) + suffix, "value option", [&counter](std::string_view v) {
+				counter += v.size();
+			});
+		}
+	}
+
+	p.freeze();
+
+	constexpr size_t num_args = 1000;
+
+	std::vector<std::string> storage;
+	storage.reserve(num_args);
+	for (size_t i = 0; i != num_args; ++i) {
+		// visit options in scattered order
+		size_t index = (i * 7919) % num_options;
+		if (index % 2 == 0) {
+			storage.push_back("--" + bench::make_key(index) + abbreviated_suffix);
+		} else {
+			storage.push_back("--" + bench::make_key(index) + abbreviated_suffix + "=value");
+		}
+	}
+
+	std::vector<std::string_view> args(storage.begin(), storage.end());
+
+	auto ns = bench::measure_ns_per_op(num_args, [&]() {
+		p.parse_views(args);
+	});
+
+	switch (mode) {
+		case lookup_mode::exact:
+			bench::report("key_lookup", num_options, ns);
+			break;
+		case lookup_mode::exact_with_abbreviations:
+			bench::report("key_lookup_abbreviations_enabled", num_options, ns);
+			break;
+		case lookup_mode::abbreviated:
+			bench::report("key_lookup_abbreviated", num_options, ns);
+			break;
+	}
+}
+} // namespace
+
+void bench::run_key_lookup()
+{
+	for (size_t n : {10, 100, 500, 2000}) {
+		bench_key_lookup(n, lookup_mode::exact);
+		bench_key_lookup(n, lookup_mode::exact_with_abbreviations);
+		bench_key_lookup(n, lookup_mode::abbreviated);
+	}
+}
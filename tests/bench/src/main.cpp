@@ -0,0 +1,39 @@
+#include <functional>
+#include <string_view>
+#include <utility>
+
+#include "bench.hpp"
+
+// Runs benchmarks of the command line arguments parser.
+// If benchmark names are given as arguments, then only those benchmarks are run.
+int main(int argc, const char** argv)
+{
+	const std::pair<std::string_view, std::function<void()>> benchmarks[] = {
+		{"key_lookup", bench::run_key_lookup},
+		{"parse", bench::run_parse},
+		{"tokens", bench::run_tokens},
+		{"command_line", bench::run_command_line},
+		{"registration", bench::run_registration},
+		{"description", bench::run_description},
+		{"concurrent_parse", bench::run_concurrent_parse},
+		{"subcommands", bench::run_subcommands},
+		{"collect", bench::run_collect},
+		{"environment", bench::run_environment},
+		{"config_files", bench::run_config_files},
+		{"suggestions", bench::run_suggestions}
+	};
+
+	for (const auto& b : benchmarks) {
+		bool run = argc <= 1;
+		for (int i = 1; i < argc; ++i) {
+			if (b.first == argv[i]) {
+				run = true;
+			}
+		}
+		if (run) {
+			b.second();
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,147 @@
+#include <vector>
+
+#include <clargs/parser.hpp>
+
+#include "bench.hpp"
+
+namespace {
+constexpr size_t num_long_options = 50;
+
+std::vector<std::string> make_command_line(size_t num_args)
+{
+	std::vector<std::string> storage;
+	storage.reserve(num_args);
+	for (size_t i = 0; i != num_args; ++i) {
+		switch (i % 4) {
+			case 0:
+				storage.push_back("--" + bench::make_key(i % num_long_options) + "=value");
+				break;
+			case 1:
+				storage.emplace_back("-xvzf");
+				break;
+			case 2:
+				storage.emplace_back("-abO3");
+				break;
+			default:
+				storage.push_back("some/file/path/" + std::to_string(i) + ".txt");
+				break;
+		}
+	}
+	return storage;
+}
+
+// measures parsing throughput of a synthetic command line consisting of
+// long key arguments, short keys batches and non-key arguments,
+// given as an array of arguments and as a NUL-separated buffer
+void bench_parse(size_t num_args)
+{
+	clargs::parser p;
+
+	size_t counter = 0;
+
+	for (size_t i = 0; i != num_long_options; ++i) {
+		p.add(bench::make_key(i), "value option", [&counter](std::string_view v) {
+			counter += v.size();
+		});
+	}
+
+	for (char c = 'a'; c <= 'z'; ++c) {
+		p.add(c, "boolean option", [&counter]() {
+			++counter;
+		});
+	}
+	p.add('O', "value option", [&counter](std::string_view v) {
+		counter += v.size();
+	});
+
+	p.add([&counter](std::string_view v) {
+		counter += v.size();
+	});
+
+	auto storage = make_command_line(num_args);
+
+	std::vector<std::string_view> args(storage.begin(), storage.end());
+
+	auto ns = bench::measure_ns_per_op(num_args, [&]() {
+		p.parse_views(args);
+	});
+
+	bench::report("parse", num_args, ns);
+
+	clargs::parse_stats stats;
+
+	ns = bench::measure_ns_per_op(num_args, [&]() {
+		p.parse(args, stats);
+	});
+
+	bench::report("parse_with_stats", num_args, ns);
+
+	std::string nul_separated;
+	for (const auto& a : storage) {
+		nul_separated.append(a).push_back('\0');
+	}
+
+	ns = bench::measure_ns_per_op(num_args, [&]() {
+		p.parse_nul_separated(nul_separated);
+	});
+
+	bench::report("parse_nul_separated", num_args, ns);
+}
+
+// measures pulling tokens of the same command line as bench_parse() does,
+// with the options dispatched by their ids instead of callbacks
+void bench_tokens(size_t num_args)
+{
+	clargs::parser p;
+
+	for (size_t i = 0; i != num_long_options; ++i) {
+		p.add(bench::make_key(i), "value option", clargs::value_kind::required);
+	}
+
+	for (char c = 'a'; c <= 'z'; ++c) {
+		p.add(c, "boolean option", clargs::value_kind::none);
+	}
+	p.add('O', "value option", clargs::value_kind::required);
+
+	p.freeze();
+
+	auto storage = make_command_line(num_args);
+
+	std::vector<std::string_view> args(storage.begin(), storage.end());
+
+	size_t counter = 0;
+
+	auto ns = bench::measure_ns_per_op(num_args, [&]() {
+		for (const auto& t : p.tokens(args)) {
+			switch (t.kind) {
+				case clargs::parser::token_kind::key:
+					if (t.has_value) {
+						counter += t.value.size();
+					} else {
+						++counter;
+					}
+					break;
+				default:
+					counter += t.value.size();
+					break;
+			}
+		}
+	});
+
+	bench::report("tokens", num_args, ns);
+}
+} // namespace
+
+void bench::run_parse()
+{
+	for (size_t n : {1, 100, 10'000, 1'000'000}) {
+		bench_parse(n);
+	}
+}
+
+void bench::run_tokens()
+{
+	for (size_t n : {1, 100, 10'000, 1'000'000}) {
+		bench_tokens(n);
+	}
+}
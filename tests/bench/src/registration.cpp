@@ -0,0 +1,67 @@
+#include <vector>
+
+#include <clargs/parser.hpp>
+
+#include "bench.hpp"
+
+namespace {
+// measures cost of registering arguments in the parser, including the parser construction and destruction
+void bench_registration(size_t num_options)
+{
+	std::vector<std::string> keys;
+	keys.reserve(num_options);
+	for (size_t i = 0; i != num_options; ++i) {
+		keys.push_back(bench::make_key(i));
+	}
+
+	auto ns = bench::measure_ns_per_op(num_options, [&]() {
+		clargs::parser p;
+		for (size_t i = 0; i != num_options; ++i) {
+			if (i % 2 == 0) {
+				p.add(keys[i], "description of a boolean option", []() {});
+			} else {
+				p.add(keys[i], "description of a value option", [](std::string_view) {});
+			}
+		}
+	});
+
+	bench::report("registration", num_options, ns);
+}
+
+// same as bench_registration(), but keys and descriptions are not copied by the parser
+void bench_registration_static(size_t num_options)
+{
+	using namespace clargs::literals;
+
+	std::vector<std::string> keys;
+	keys.reserve(num_options);
+	for (size_t i = 0; i != num_options; ++i) {
+		keys.push_back(bench::make_key(i));
+	}
+
+	auto ns = bench::measure_ns_per_op(num_options, [&]() {
+		clargs::parser p;
+		for (size_t i = 0; i != num_options; ++i) {
+			// the keys outlive the parser
+			auto key = clargs::static_string(keys[i]);
+			if (i % 2 == 0) {
+				p.add(key, "description of a boolean option"_static, []() {});
+			} else {
+				p.add(key, "description of a value option"_static, [](std::string_view) {});
+			}
+		}
+	});
+
+	bench::report("registration_static", num_options, ns);
+}
+} // namespace
+
+void bench::run_registration()
+{
+	for (size_t n : {10, 100, 1000}) {
+		bench_registration(n);
+	}
+	for (size_t n : {10, 100, 1000}) {
+		bench_registration_static(n);
+	}
+}
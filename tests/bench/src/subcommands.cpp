@@ -0,0 +1,65 @@
+#include <string>
+#include <vector>
+
+#include <clargs/parser.hpp>
+
+#include "bench.hpp"
+
+namespace {
+// measures setting up a parser with the given number of subcommands and parsing a command line
+// invoking one of them, an operation is one setup and parse
+void bench_subcommands(size_t num_subcommands)
+{
+	constexpr size_t num_subcommand_options = 20;
+
+	std::vector<std::string> names;
+	names.reserve(num_subcommands);
+	for (size_t i = 0; i != num_subcommands; ++i) {
+		names.push_back("command-" + std::to_string(i));
+	}
+
+	std::vector<std::string> keys;
+	keys.reserve(num_subcommand_options);
+	for (size_t i = 0; i != num_subcommand_options; ++i) {
+		keys.push_back(bench::make_key(i));
+	}
+
+	std::vector<std::string_view> args = {
+		"--verbose",
+		names[num_subcommands / 2],
+		"--option-number-1=value",
+		"--verbose",
+		"file.txt"
+	};
+
+	size_t counter = 0;
+
+	auto ns = bench::measure_ns_per_op(1, [&]() {
+		clargs::parser p;
+		p.add('v', "verbose", "global option", [&counter]() {
+			++counter;
+		});
+
+		for (const auto& name : names) {
+			p.add_subcommand(name, [&](clargs::parser& sp) {
+				for (const auto& k : keys) {
+					sp.add(k, "subcommand option", [&counter](std::string_view v) {
+						counter += v.size();
+					});
+				}
+			});
+		}
+
+		p.parse_views(args);
+	});
+
+	bench::report("subcommands", num_subcommands, ns);
+}
+} // namespace
+
+void bench::run_subcommands()
+{
+	for (size_t n : {10, 300}) {
+		bench_subcommands(n);
+	}
+}
@@ -0,0 +1,46 @@
+#include <vector>
+
+#include <clargs/parser.hpp>
+
+#include "bench.hpp"
+
+namespace {
+// measures looking for the registered keys similar to the misspelled one
+// in a parser with many registered arguments, an operation is one lookup
+void bench_suggestions(size_t num_options)
+{
+	clargs::parser p;
+
+	for (size_t i = 0; i != num_options; ++i) {
+		p.add(bench::make_key(i), "value option", [](std::string_view) {});
+	}
+	p.freeze();
+
+	// misspelled key of the option in the middle
+	auto key = bench::make_key(num_options / 2);
+	std::swap(key[1], key[2]);
+
+	size_t num_suggestions = 0;
+
+	constexpr size_t num_lookups = 100;
+
+	auto ns = bench::measure_ns_per_op(num_lookups, [&]() {
+		for (size_t i = 0; i != num_lookups; ++i) {
+			num_suggestions += p.suggest(key).size();
+		}
+	});
+
+	bench::report("suggestions", num_options, ns);
+
+	if (num_suggestions == 0) {
+		std::cerr << "no suggestions found" << std::endl;
+	}
+}
+} // namespace
+
+void bench::run_suggestions()
+{
+	for (size_t n : {10, 100, 1000, 5000}) {
+		bench_suggestions(n);
+	}
+}
@@ -0,0 +1,84 @@
+#include <string>
+
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include <clargs/parser.hpp>
+
+using namespace std::string_literals;
+
+namespace{
+const tst::set set("arena", [](tst::suite& suite){
+	suite.add("many_arguments_are_registered", []{
+		clargs::parser p;
+
+		const size_t num_arguments = 3000;
+
+		std::vector<size_t> counts(num_arguments, 0);
+
+		for(size_t i = 0; i != num_arguments; ++i){
+			// long descriptions do not fit into the arena blocks
+			auto description = std::string(i % 100 == 0 ? 0x10000 : 10, 'd');
+			auto id = p.add("key-"s + std::to_string(i), description, [&counts, i](){ ++counts[i]; });
+			tst::check_eq(id, i, SL);
+		}
+
+		std::vector<const char*> args = {"--key-0", "--key-1234", "--key-2999", "--key-1234"};
+		auto non_key = p.parse(utki::make_span(args));
+
+		tst::check(non_key.empty(), SL);
+		tst::check_eq(counts[0], size_t(1), SL);
+		tst::check_eq(counts[1234], size_t(2), SL);
+		tst::check_eq(counts[2999], size_t(1), SL);
+		tst::check_eq(counts[1], size_t(0), SL);
+	});
+
+	suite.add("duplicate_argument_is_rejected", []{
+		clargs::parser p;
+
+		p.add('a', "aaa", "description", [](){});
+		p.add('b', "description", [](){});
+
+		bool long_key_thrown = false;
+		try{
+			p.add("aaa", "description", [](){});
+		}catch(std::logic_error&){
+			long_key_thrown = true;
+		}
+		tst::check(long_key_thrown, SL);
+
+		bool short_key_thrown = false;
+		try{
+			p.add('b', "description", [](){});
+		}catch(std::logic_error&){
+			short_key_thrown = true;
+		}
+		tst::check(short_key_thrown, SL);
+
+		// the rejected arguments are not registered
+		tst::check_eq(p.add('c', "ccc", "description", [](){}), size_t(2), SL);
+	});
+
+	suite.add("moved_parser_keeps_arguments", []{
+		bool a = false;
+		std::string b;
+
+		clargs::parser p;
+		p.add('a', "aaa", "boolean argument", [&a](){ a = true; });
+		p.add("bbb", "value argument", [&b](std::string_view v){ b = v; });
+
+		clargs::parser q(std::move(p));
+
+		clargs::parser r;
+		r.add("ccc", "other argument", [](){});
+		r = std::move(q);
+
+		std::vector<const char*> args = {"-a", "--bbb=hello"};
+		r.parse(utki::make_span(args));
+
+		tst::check(a, SL);
+		tst::check_eq(b, std::string("hello"), SL);
+		tst::check(r.description().find("--bbb=VALUE") != std::string::npos, SL);
+	});
+});
+}
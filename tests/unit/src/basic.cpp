@@ -484,5 +484,68 @@ const tst::set set("basic", [](tst::suite& suite){
 
 		tst::check_eq(a, unsigned(3), SL) << "a = " << a;
 	});
+
+	suite.add("parser_can_be_reused_after_stop", [](){
+		clargs::parser p;
+
+		unsigned a = 0;
+
+		p.add('a', "aaa", "description", [&a, &p](){
+			++a;
+			p.stop();
+		});
+
+		std::vector<const char*> args = {{
+			"-a",
+			"--aaa"
+		}};
+
+		p.parse(utki::make_span(args));
+		tst::check_eq(a, unsigned(1), SL) << "a = " << a;
+
+		p.parse(utki::make_span(args));
+		tst::check_eq(a, unsigned(2), SL) << "a = " << a;
+	});
+
+	suite.add("parser_can_be_reused_after_minus_minus", [](){
+		clargs::parser p;
+
+		unsigned a = 0;
+
+		p.add('a', "aaa", "description", [&a](){++a;});
+
+		std::vector<const char*> args = {{
+			"-a",
+			"--",
+			"--aaa"
+		}};
+
+		auto res = p.parse(utki::make_span(args));
+		tst::check_eq(a, unsigned(1), SL) << "a = " << a;
+		tst::check_eq(res.size(), size_t(1), SL) << "res.size() = " << res.size();
+
+		res = p.parse(utki::make_span(args));
+		tst::check_eq(a, unsigned(2), SL) << "a = " << a;
+		tst::check_eq(res.size(), size_t(1), SL) << "res.size() = " << res.size();
+	});
+
+	suite.add("long_key_argument_does_not_match_short_only_key", [](){
+		clargs::parser p;
+
+		p.add('a', "description", [](){});
+
+		std::vector<const char*> args = {{
+			"-- a"
+		}};
+
+		bool exception_caught = false;
+		try{
+			p.parse(utki::make_span(args));
+		}catch(std::invalid_argument& e){
+			exception_caught = true;
+			tst::check_eq(std::string(e.what()), "unknown argument: -- a"s, SL) << "e.what() = " << e.what();
+		}
+		tst::check(exception_caught, SL);
+	});
 });
 }
@@ -0,0 +1,119 @@
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include <clargs/parser.hpp>
+
+using namespace std::string_literals;
+using namespace std::string_view_literals;
+
+namespace{
+const tst::set set("collect", [](tst::suite& suite){
+	suite.add("values_are_collected_as_views", []{
+		std::vector<std::string_view> includes;
+		bool verbose = false;
+
+		clargs::parser p;
+		p.add('I', "include", "include directory", includes);
+		p.add('v', "verbose", "verbose output", verbose);
+
+		std::vector<std::string_view> args = {
+			"-I", "aaa", "-Ibbb", "-v", "--include=ccc", "-I", "ddd", "nonkey"
+		};
+		auto non_key = p.parse(utki::make_span(args));
+
+		tst::check(verbose, SL);
+		tst::check_eq(non_key.size(), size_t(1), SL);
+		tst::check_eq(includes.size(), size_t(4), SL);
+		tst::check(includes[0] == "aaa"sv, SL);
+		tst::check(includes[1] == "bbb"sv, SL);
+		tst::check(includes[2] == "ccc"sv, SL);
+		tst::check(includes[3] == "ddd"sv, SL);
+
+		// the values are views into the args
+		tst::check(includes[0].data() == args[1].data(), SL);
+		tst::check(includes[3].data() == args[6].data(), SL);
+
+		// the capacity is reserved in advance
+		tst::check(includes.capacity() >= 4, SL);
+	});
+
+	suite.add("capacity_is_reserved_for_keys_in_batches", []{
+		std::vector<std::string_view> includes;
+		std::vector<std::string_view> libs;
+		bool verbose = false;
+
+		clargs::parser p;
+		p.add('I', "include", "include directory", includes);
+		p.add('l', "lib", "library", libs);
+		p.add('v', "verbose", "verbose output", verbose);
+
+		std::vector<std::string_view> args = {
+			"-vIaaa", "-vl", "m", "-vvIl", "--include=ccc", "-lpthread"
+		};
+		p.parse(utki::make_span(args));
+
+		tst::check(verbose, SL);
+		tst::check(includes == std::vector<std::string_view>{"aaa", "l", "ccc"}, SL) << "includes.size() = " << includes.size();
+		tst::check(libs == std::vector<std::string_view>{"m", "pthread"}, SL) << "libs.size() = " << libs.size();
+
+		// reserved for all the occurrences at once, the value of the key in a batch is not counted as a key
+		tst::check_eq(includes.capacity(), size_t(3), SL);
+		tst::check_eq(libs.capacity(), size_t(2), SL);
+	});
+
+	suite.add("values_are_collected_as_strings_and_numbers", []{
+		std::vector<std::string> names;
+		std::vector<int> levels;
+
+		clargs::parser p;
+		p.add("name", "name", names);
+		p.add('l', "level", levels);
+
+		auto non_key = p.parse("--name='hello world' -l 1 -l2 --name=x"sv);
+
+		tst::check(non_key.empty(), SL);
+		tst::check_eq(names.size(), size_t(2), SL);
+		tst::check_eq(names[0], "hello world"s, SL);
+		tst::check_eq(names[1], "x"s, SL);
+		tst::check_eq(levels.size(), size_t(2), SL);
+		tst::check_eq(levels[0], 1, SL);
+		tst::check_eq(levels[1], 2, SL);
+	});
+
+	suite.add("invalid_value_is_reported", []{
+		std::vector<int> levels;
+
+		clargs::parser p;
+		p.add('l', "level", "level", levels);
+
+		std::vector<std::string_view> args = {"-l", "1", "--level=abc"};
+
+		std::vector<std::string_view> non_key;
+		auto error = p.try_parse(utki::make_span(args), non_key);
+
+		tst::check(error.code == clargs::error_code::invalid_value, SL);
+		tst::check_eq(levels.size(), size_t(1), SL);
+	});
+
+	suite.add("transient_values_cannot_be_collected_as_views", []{
+		std::vector<std::string_view> includes;
+
+		clargs::parser p;
+		p.add('I', "include directory", includes);
+
+		bool thrown = false;
+		try{
+			p.parse("-I aaa"sv);
+		}catch(std::logic_error& e){
+			thrown = true;
+			tst::check_eq(
+				std::string(e.what()),
+				"value of argument 'I' is only valid during parsing and cannot be collected as a view"s,
+				SL
+			);
+		}
+		tst::check(thrown, SL);
+		tst::check(includes.empty(), SL);
+	});
+});
+}
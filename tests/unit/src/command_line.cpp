@@ -0,0 +1,144 @@
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include <clargs/parser.hpp>
+
+using namespace std::string_literals;
+using namespace std::string_view_literals;
+
+namespace{
+const tst::set set("command_line", [](tst::suite& suite){
+	suite.add("command_line_is_split_into_arguments", []{
+		clargs::parser p;
+
+		std::vector<std::string> res;
+
+		p.add('a', "aaa", "description", [&res](){res.emplace_back("a");});
+		p.add("bbb", "description", [&res](std::string_view v){res.push_back("b = "s.append(v));});
+		p.add('c', "description", [&res](std::string_view v){res.push_back("c = "s.append(v));});
+
+		auto non_key = p.parse(
+			"  first -a\t\"double quoted\" 'single quoted' escaped\\ space\n"
+			"--bbb=\"b \\\"val\\\"\" -c \"\" mixed'single'\"double\"\\\\end\r\n"
+			"some_very_long_argument_which_is_longer_than_the_simd_block_size_for_sure "
+			"'some very long single quoted argument which is longer than the simd block size' "
+			"last  "sv
+		);
+
+		std::vector<std::string> expected = {
+			"a",
+			"b = b \"val\"",
+			"c = "
+		};
+		tst::check(res == expected, SL) << "res.size() = " << res.size();
+
+		std::vector<std::string> expected_non_key = {
+			"first",
+			"double quoted",
+			"single quoted",
+			"escaped space",
+			"mixedsingledouble\\end",
+			"some_very_long_argument_which_is_longer_than_the_simd_block_size_for_sure",
+			"some very long single quoted argument which is longer than the simd block size",
+			"last"
+		};
+		tst::check(non_key == expected_non_key, SL) << "non_key.size() = " << non_key.size();
+	});
+
+	suite.add("long_double_quoted_arguments_are_unescaped", []{
+		clargs::parser p;
+
+		auto non_key = p.parse(
+			"\"some very long double quoted argument which is longer than the simd block size\" "
+			"\"escapes \\\"at\\\" different\\\\offsets within the simd blocks \\\"and\\\" a \\kept backslash\\\\\" "
+			"\"0123456789abcdefghijklmnopqrstuv\\\"0123456789abcdefghijklmnopqrstu\\\\\"tail"sv
+		);
+
+		std::vector<std::string> expected = {
+			"some very long double quoted argument which is longer than the simd block size",
+			"escapes \"at\" different\\offsets within the simd blocks \"and\" a \\kept backslash\\",
+			"0123456789abcdefghijklmnopqrstuv\"0123456789abcdefghijklmnopqrstu\\tail"
+		};
+		tst::check(non_key == expected, SL) << "non_key.size() = " << non_key.size();
+
+		bool exception_caught = false;
+		try{
+			p.parse("\"some very long double quoted argument which is not terminated \\\""sv);
+		}catch(std::invalid_argument& e){
+			exception_caught = true;
+		}
+		tst::check(exception_caught, SL);
+	});
+
+	suite.add("unquoted_arguments_are_views_into_command_line", []{
+		clargs::parser p;
+
+		std::string_view value;
+		p.add('a', "description", [&value](std::string_view v){value = v;});
+
+		auto command_line = "-a some_value"sv;
+
+		p.parse(command_line);
+
+		tst::check_eq(value, "some_value"sv, SL);
+		tst::check(value.data() == command_line.data() + 3, SL);
+	});
+
+	suite.add("empty_command_line", []{
+		clargs::parser p;
+
+		auto res = p.parse(""sv);
+		tst::check(res.empty(), SL);
+
+		res = p.parse(" \t\n"sv);
+		tst::check(res.empty(), SL);
+	});
+
+	suite.add("subcommand_gets_remaining_arguments", []{
+		clargs::parser p;
+
+		std::vector<std::string> res;
+		p.add([&res](std::string_view command, utki::span<std::string_view> args){
+			res.emplace_back(command);
+			for(const auto& a : args){
+				res.emplace_back(a);
+			}
+		});
+
+		p.parse("command -b 'quoted arg'"sv);
+
+		std::vector<std::string> expected = {
+			"command",
+			"-b",
+			"quoted arg"
+		};
+		tst::check(res == expected, SL) << "res.size() = " << res.size();
+	});
+
+	suite.add("unterminated_quote", []{
+		clargs::parser p;
+
+		bool exception_caught = false;
+		try{
+			p.parse("one \"two"sv);
+		}catch(std::invalid_argument& e){
+			exception_caught = true;
+			tst::check_eq(e.what(), "unterminated quote in command line"s, SL);
+		}
+		tst::check(exception_caught, SL);
+	});
+
+	suite.add("unknown_argument", []{
+		clargs::parser p;
+
+		bool exception_caught = false;
+		try{
+			p.parse("one 'two' --unknown"sv);
+		}catch(std::invalid_argument& e){
+			exception_caught = true;
+			tst::check_eq(e.what(), "unknown argument: --unknown"s, SL);
+		}
+		tst::check(exception_caught, SL);
+	});
+});
+}
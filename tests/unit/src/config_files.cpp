@@ -0,0 +1,192 @@
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include <clargs/parser.hpp>
+
+#include "temp_file.hpp"
+
+using namespace std::string_literals;
+using namespace std::string_view_literals;
+
+namespace{
+const tst::set set("config_files", [](tst::suite& suite){
+	suite.add("config_file_arguments_are_handled", []{
+		temp_file file(
+			"clargs_test_config_file_1.conf",
+			"# comment\n"
+			"\n"
+			"level = 10\n"
+			"  name=hello world  \r\n"
+			"verbose\n"
+			"quiet = no\n"
+			"color = on\n"
+			"include = aaa\n"
+			"include = bbb"
+		);
+
+		int level = 0;
+		std::string name;
+		bool verbose = false;
+		bool quiet = false;
+		bool color = false;
+		std::vector<std::string> includes;
+
+		clargs::parser p;
+		p.add('l', "level", "level", level);
+		p.add("name", "name", name);
+		p.add('v', "verbose", "verbose output", verbose);
+		p.add('q', "quiet", "quiet output", quiet);
+		p.add("color", "colored output", color);
+		p.add('I', "include", "include directory", includes);
+
+		p.add_config_file(file.path);
+
+		auto non_key = p.parse("file"sv);
+
+		tst::check_eq(non_key.size(), size_t(1), SL);
+		tst::check_eq(level, 10, SL);
+		tst::check_eq(name, "hello world"s, SL);
+		tst::check(verbose, SL);
+		tst::check(!quiet, SL);
+		tst::check(color, SL);
+		tst::check_eq(includes.size(), size_t(2), SL);
+		tst::check_eq(includes[0], "aaa"s, SL);
+		tst::check_eq(includes[1], "bbb"s, SL);
+	});
+
+	suite.add("later_config_files_and_command_line_take_precedence", []{
+		temp_file file1(
+			"clargs_test_config_file_2.conf",
+			"level = 1\n"
+			"name = first\n"
+			"include = aaa\n"
+			"include = bbb\n"
+			"size = 3\n"
+		);
+		temp_file file2(
+			"clargs_test_config_file_3.conf",
+			"level = 2\n"
+			"include = ccc\n"
+		);
+
+		int level = 0;
+		std::string name;
+		std::vector<std::string> includes;
+		int size = 0;
+
+		clargs::parser p;
+		p.add('l', "level", "level", level);
+		p.add("name", "name", name);
+		p.add('I', "include", "include directory", includes);
+		p.add('s', "size", "size", size);
+
+		p.add_config_file(file1.path);
+		p.add_config_file("clargs_test_non_existing_config_file.conf");
+		p.add_config_file(file2.path);
+
+		p.parse("-s 13"sv);
+
+		tst::check_eq(level, 2, SL);
+		tst::check_eq(name, "first"s, SL);
+		tst::check_eq(includes.size(), size_t(1), SL);
+		tst::check_eq(includes[0], "ccc"s, SL);
+		tst::check_eq(size, 13, SL);
+	});
+
+	suite.add("error_in_config_file_is_reported_with_line", []{
+		temp_file file(
+			"clargs_test_config_file_4.conf",
+			"level = 1\n"
+			"\n"
+			"level = abc\n"
+		);
+
+		int level = 0;
+
+		clargs::parser p;
+		p.add('l', "level", "level", level);
+		p.add_config_file(file.path);
+
+		clargs::parse_error error;
+		{
+			std::vector<std::string_view> args;
+			std::vector<std::string_view> non_key;
+			error = p.try_parse(utki::make_span(args), non_key);
+		}
+
+		tst::check(error.code == clargs::error_code::invalid_value, SL);
+		tst::check_eq(error.line, size_t(3), SL);
+		tst::check_eq(error.file, std::string_view(file.path), SL);
+		tst::check_eq(error.argument, "level = abc"sv, SL);
+		tst::check_eq(error.value, "abc"sv, SL);
+		tst::check_eq(
+			error.message(),
+			"clargs_test_config_file_4.conf:3: invalid value of argument 'level': abc"s,
+			SL
+		);
+	});
+
+	suite.add("empty_value_is_invalid_for_boolean_argument", []{
+		temp_file file("clargs_test_config_file_6.conf", "verbose =\n");
+
+		bool verbose = false;
+		bool handled = false;
+
+		clargs::parser p;
+		p.add('v', "verbose", "verbose output", verbose);
+		p.add_config_file(file.path);
+
+		clargs::parse_error error;
+		{
+			std::vector<std::string_view> args;
+			std::vector<std::string_view> non_key;
+			error = p.try_parse(utki::make_span(args), non_key);
+		}
+
+		tst::check(error.code == clargs::error_code::invalid_value, SL);
+		tst::check_eq(error.line, size_t(1), SL);
+		tst::check_eq(error.argument, "verbose ="sv, SL);
+		tst::check(!verbose, SL);
+
+		// boolean argument with handler
+		temp_file quiet_file("clargs_test_config_file_7.conf", "quiet =\n");
+
+		clargs::parser quiet_parser;
+		quiet_parser.add('q', "quiet", "quiet output", [&](){
+			handled = true;
+		});
+		quiet_parser.add_config_file(quiet_file.path);
+
+		{
+			std::vector<std::string_view> args;
+			std::vector<std::string_view> non_key;
+			error = quiet_parser.try_parse(utki::make_span(args), non_key);
+		}
+
+		tst::check(error.code == clargs::error_code::invalid_value, SL);
+		tst::check_eq(error.argument, "quiet ="sv, SL);
+		tst::check(!handled, SL);
+	});
+
+	suite.add("unknown_key_in_config_file_throws", []{
+		temp_file file("clargs_test_config_file_5.conf", "unknown = 1\n");
+
+		clargs::parser p;
+		p.add('l', "level", "level", [](std::string_view){});
+		p.add_config_file(file.path);
+
+		bool thrown = false;
+		try{
+			p.parse(""sv);
+		}catch(std::invalid_argument& e){
+			thrown = true;
+			tst::check_eq(
+				std::string(e.what()),
+				"clargs_test_config_file_5.conf:1: unknown argument: unknown = 1"s,
+				SL
+			);
+		}
+		tst::check(thrown, SL);
+	});
+});
+}
@@ -0,0 +1,63 @@
+#include <sstream>
+
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include <clargs/parser.hpp>
+
+using namespace std::string_literals;
+
+namespace{
+const tst::set set("description", [](tst::suite& suite){
+	suite.add("description_is_formatted", []{
+		clargs::parser p;
+
+		p.add('a', "aaa", "boolean argument", [](){});
+		p.add('b', "short only value argument", [](std::string_view){});
+		p.add("ccc", "optional value argument", [](std::string_view){}, [](){});
+		p.add("some-very-long-key-name", "value argument with long key", [](std::string_view){});
+
+		auto expected =
+				"  -a, --aaa   boolean argument\n"
+				"  -b VALUE    short only value argument\n"
+				"      --ccc[=VALUE]\n"
+				"              optional value argument\n"
+				"      --some-very-long-key-name=VALUE\n"
+				"              value argument with long key\n"s;
+
+		tst::check_eq(p.description(12), expected, SL) << "description =\n" << p.description(12);
+	});
+
+	suite.add("write_description_writes_same_text", []{
+		clargs::parser p;
+
+		p.add('a', "aaa", "boolean argument", [](){});
+		p.add("bbb", "value argument", [](std::string_view){});
+
+		std::stringstream ss;
+		p.write_description(ss);
+
+		tst::check_eq(ss.str(), p.description(), SL);
+
+		ss.str("");
+		p.write_description(ss, 10, 20);
+
+		tst::check_eq(ss.str(), p.description(10, 20), SL);
+	});
+
+	suite.add("description_is_updated_after_adding_argument", []{
+		clargs::parser p;
+
+		p.add('a', "aaa", "boolean argument", [](){});
+
+		auto before = p.description();
+
+		p.add("bbb", "value argument", [](std::string_view){});
+
+		auto after = p.description();
+
+		tst::check_ne(before, after, SL);
+		tst::check_eq(after.substr(0, before.size()), before, SL);
+	});
+});
+}
@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include <clargs/edit_distance.hpp>
+#include <clargs/parser.hpp>
+
+using namespace std::string_literals;
+
+namespace{
+// plain dynamic programming Levenshtein distance
+size_t reference_distance(std::string_view a, std::string_view b){
+	std::vector<size_t> row(b.size() + 1);
+	for(size_t j = 0; j != row.size(); ++j){
+		row[j] = j;
+	}
+	for(size_t i = 0; i != a.size(); ++i){
+		size_t diagonal = row[0];
+		row[0] = i + 1;
+		for(size_t j = 0; j != b.size(); ++j){
+			size_t above = row[j + 1];
+			row[j + 1] = std::min({above + 1, row[j] + 1, diagonal + (a[i] == b[j] ? 0 : 1)});
+			diagonal = above;
+		}
+	}
+	return row.back();
+}
+
+size_t bounded(size_t distance, size_t max_distance){
+	return distance > max_distance ? max_distance + 1 : distance;
+}
+
+std::string random_string(std::mt19937& gen, size_t max_length, std::string_view alphabet){
+	std::uniform_int_distribution<size_t> length_dist(0, max_length);
+	std::uniform_int_distribution<size_t> char_dist(0, alphabet.size() - 1);
+
+	std::string ret(length_dist(gen), '\0');
+	for(auto& c : ret){
+		c = alphabet[char_dist(gen)];
+	}
+	return ret;
+}
+}
+
+namespace{
+const tst::set set("edit_distance", [](tst::suite& suite){
+	suite.add("distance_of_empty_strings", []{
+		clargs::edit_distance_matcher empty("");
+
+		tst::check_eq(empty.distance("", 3), size_t(0), SL);
+		tst::check_eq(empty.distance("ab", 3), size_t(2), SL);
+		tst::check_eq(empty.distance("abcd", 3), size_t(4), SL);
+		tst::check_eq(empty.first_column().distance, size_t(0), SL);
+
+		clargs::edit_distance_matcher abc("abc");
+
+		tst::check_eq(abc.distance("", 3), size_t(3), SL);
+		tst::check_eq(abc.distance("", 2), size_t(3), SL);
+		tst::check_eq(abc.first_column().distance, size_t(3), SL);
+	});
+
+	suite.add("distance_of_simple_edits", []{
+		clargs::edit_distance_matcher m("verbose");
+
+		tst::check_eq(m.distance("verbose", 3), size_t(0), SL);
+		tst::check_eq(m.distance("verbse", 3), size_t(1), SL);
+		tst::check_eq(m.distance("verbosee", 3), size_t(1), SL);
+		tst::check_eq(m.distance("verbXse", 3), size_t(1), SL);
+		tst::check_eq(m.distance("vrebose", 3), size_t(2), SL);
+		tst::check_eq(m.distance("output", 3), size_t(4), SL);
+		tst::check_eq(m.distance("output", 10), size_t(7), SL);
+	});
+
+	suite.add("distance_is_same_as_of_reference_implementation", []{
+		std::mt19937 gen(13);
+
+		// small alphabets make close strings, so that small distances are covered too
+		for(std::string_view alphabet : {"ab", "abcd", "abcdefghijklmnopqrstuvwxyz-\xC3\xA9"}){
+			for(size_t i = 0; i != 3000; ++i){
+				auto pattern = random_string(gen, clargs::edit_distance_matcher::max_pattern_length, alphabet);
+				auto str = random_string(gen, clargs::edit_distance_matcher::max_pattern_length + 36, alphabet);
+
+				clargs::edit_distance_matcher m(pattern);
+
+				auto expected = reference_distance(pattern, str);
+
+				for(size_t max_distance : {size_t(0), size_t(1), size_t(3), size_t(10), size_t(200)}){
+					auto d = m.distance(str, max_distance);
+					tst::check_eq(d, bounded(expected, max_distance), SL)
+						<< "pattern = " << pattern << ", str = " << str << ", max_distance = " << max_distance;
+				}
+
+				// columns computed incrementally give the same distance
+				auto c = m.first_column();
+				for(char ch : str){
+					c = m.next_column(c, ch);
+				}
+				tst::check_eq(c.distance, expected, SL) << "pattern = " << pattern << ", str = " << str;
+			}
+		}
+	});
+
+	suite.add("distance_to_pattern_of_maximum_length", []{
+		std::string pattern(clargs::edit_distance_matcher::max_pattern_length, 'a');
+		clargs::edit_distance_matcher m(pattern);
+
+		tst::check_eq(m.distance(pattern, 3), size_t(0), SL);
+		tst::check_eq(m.distance(pattern + "b", 3), size_t(1), SL);
+		tst::check_eq(m.distance("b" + pattern.substr(1), 3), size_t(1), SL);
+		tst::check_eq(m.distance(pattern + pattern, 100), pattern.size(), SL);
+		tst::check_eq(m.distance("", 100), pattern.size(), SL);
+	});
+
+	suite.add("keys_longer_than_maximum_pattern_length_get_no_suggestions", []{
+		std::string key(clargs::edit_distance_matcher::max_pattern_length + 1, 'a');
+
+		clargs::parser p;
+		p.add(key, "long key", [](){});
+
+		// the key only differs in the last character
+		auto misspelled = key;
+		misspelled.back() = 'b';
+
+		tst::check(p.suggest(misspelled).empty(), SL);
+		tst::check(p.suggest(key.substr(1)) == std::vector<std::string>{key}, SL);
+	});
+});
+}
@@ -0,0 +1,213 @@
+#include <utki/config.hpp>
+
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include <clargs/parser.hpp>
+
+#if CFG_OS != CFG_OS_WINDOWS
+#	include <cstdlib>
+#endif
+
+using namespace std::string_literals;
+using namespace std::string_view_literals;
+
+namespace{
+const tst::set set("environment", [](tst::suite& suite){
+	suite.add("duplicate_variable_name_throws", []{
+		clargs::parser p;
+		auto a = p.add("aaa", "aaa", [](std::string_view){});
+		auto b = p.add("bbb", "bbb", [](std::string_view){});
+
+		p.add_environment_variable(a, "CLARGS_TEST_DUPLICATE");
+
+		bool thrown = false;
+		try{
+			p.add_environment_variable(b, "CLARGS_TEST_DUPLICATE");
+		}catch(std::logic_error&){
+			thrown = true;
+		}
+		tst::check(thrown, SL);
+
+		thrown = false;
+		try{
+			p.add_environment_variable(b + 1, "CLARGS_TEST_UNKNOWN_ARGUMENT");
+		}catch(std::logic_error&){
+			thrown = true;
+		}
+		tst::check(thrown, SL);
+	});
+
+#if CFG_OS != CFG_OS_WINDOWS
+	suite.add("variable_is_used_when_argument_is_not_given", []{
+		setenv("CLARGS_TEST_LEVEL", "13", 1);
+		setenv("CLARGS_TEST_VERBOSE", "yes", 1);
+		setenv("CLARGS_TEST_QUIET", "off", 1);
+
+		int level = 0;
+		bool verbose = false;
+		bool quiet = false;
+
+		clargs::parser p;
+		p.add_environment_variable(p.add('l', "level", "level", level), "CLARGS_TEST_LEVEL");
+		p.add_environment_variable(p.add('v', "verbose", "verbose output", verbose), "CLARGS_TEST_VERBOSE");
+		p.add_environment_variable(p.add('q', "quiet", "quiet output", quiet), "CLARGS_TEST_QUIET");
+
+		auto non_key = p.parse("file"sv);
+
+		tst::check_eq(non_key.size(), size_t(1), SL);
+		tst::check_eq(level, 13, SL);
+		tst::check(verbose, SL);
+		tst::check(!quiet, SL);
+
+		unsetenv("CLARGS_TEST_LEVEL");
+		unsetenv("CLARGS_TEST_VERBOSE");
+		unsetenv("CLARGS_TEST_QUIET");
+	});
+
+	suite.add("command_line_takes_precedence", []{
+		setenv("CLARGS_TEST_NAME", "from_environment", 1);
+		setenv("CLARGS_TEST_NAME_OLD", "from_old_environment", 1);
+
+		std::vector<std::string> names;
+
+		clargs::parser p;
+		auto id = p.add('n', "name", [&](std::string_view v){
+			names.emplace_back(v);
+		});
+		p.add_environment_variable(id, "CLARGS_TEST_NAME");
+		p.add_environment_variable(id, "CLARGS_TEST_NAME_OLD");
+
+		p.parse("-n from_command_line"sv);
+
+		tst::check_eq(names.size(), size_t(1), SL);
+		tst::check_eq(names.front(), "from_command_line"s, SL);
+
+		// only the variable added first is used
+		names.clear();
+		p.parse(""sv);
+
+		tst::check_eq(names.size(), size_t(1), SL);
+		tst::check_eq(names.front(), "from_environment"s, SL);
+
+		unsetenv("CLARGS_TEST_NAME");
+		unsetenv("CLARGS_TEST_NAME_OLD");
+	});
+
+	suite.add("environment_variable_added_first_takes_precedence", []{
+		setenv("CLARGS_TEST_NAME", "from_environment", 1);
+		setenv("CLARGS_TEST_NAME_OLD", "from_old_environment", 1);
+
+		std::vector<std::string> names;
+
+		// the variables are added in the reverse order, so whatever the order of the variables in the environment is,
+		// one of the parsers would use the wrong one in case the order of the environment was followed
+		clargs::parser p;
+		auto id = p.add('n', "name", [&](std::string_view v){
+			names.emplace_back(v);
+		});
+		p.add_environment_variable(id, "CLARGS_TEST_NAME_OLD");
+		p.add_environment_variable(id, "CLARGS_TEST_NAME");
+
+		p.parse(""sv);
+
+		tst::check_eq(names.size(), size_t(1), SL);
+		tst::check_eq(names.front(), "from_old_environment"s, SL);
+
+		// the variable added first is not set
+		unsetenv("CLARGS_TEST_NAME_OLD");
+
+		names.clear();
+		p.parse(""sv);
+
+		tst::check_eq(names.size(), size_t(1), SL);
+		tst::check_eq(names.front(), "from_environment"s, SL);
+
+		unsetenv("CLARGS_TEST_NAME");
+	});
+
+	suite.add("subcommand_arguments_are_taken_from_environment", []{
+		setenv("CLARGS_TEST_FORCE", "1", 1);
+		setenv("CLARGS_TEST_COLOR", "0", 1);
+
+		bool force = false;
+		bool color = false;
+
+		clargs::parser p;
+		p.add_environment_variable(p.add("color", "colored output", color), "CLARGS_TEST_COLOR");
+		p.add_subcommand("push", [&](clargs::parser& sp){
+			sp.add_environment_variable(sp.add('f', "force", "force push", force), "CLARGS_TEST_FORCE");
+		});
+
+		p.parse("--color push"sv);
+
+		tst::check(force, SL);
+
+		// given in the command line of the parent parser
+		tst::check(color, SL);
+
+		unsetenv("CLARGS_TEST_FORCE");
+		unsetenv("CLARGS_TEST_COLOR");
+	});
+
+	suite.add("invalid_value_is_reported", []{
+		setenv("CLARGS_TEST_BAD_LEVEL", "abc", 1);
+
+		int level = 0;
+
+		clargs::parser p;
+		p.add_environment_variable(p.add('l', "level", "level", level), "CLARGS_TEST_BAD_LEVEL");
+
+		std::vector<std::string_view> args;
+		std::vector<std::string_view> non_key;
+		auto error = p.try_parse(utki::make_span(args), non_key);
+
+		tst::check(error.code == clargs::error_code::invalid_value, SL);
+		tst::check_eq(error.argument, "CLARGS_TEST_BAD_LEVEL=abc"sv, SL);
+
+		unsetenv("CLARGS_TEST_BAD_LEVEL");
+	});
+
+	suite.add("empty_value_is_invalid_for_boolean_argument", []{
+		setenv("CLARGS_TEST_EMPTY_VERBOSE", "", 1);
+		setenv("CLARGS_TEST_EMPTY_OUTPUT", "", 1);
+
+		bool verbose = false;
+		std::vector<std::string> outputs;
+
+		clargs::parser p;
+		auto verbose_id = p.add('v', "verbose", "verbose output", verbose);
+		p.add_environment_variable(
+			p.add(
+				"output",
+				"optional value argument",
+				[&](std::string_view v){
+					outputs.emplace_back(v);
+				},
+				[&](){
+					outputs.emplace_back("default");
+				}
+			),
+			"CLARGS_TEST_EMPTY_OUTPUT"
+		);
+
+		// argument with optional value is handled without value
+		p.parse(""sv);
+		tst::check(outputs == std::vector<std::string>{"default"}, SL) << "outputs.size() = " << outputs.size();
+
+		p.add_environment_variable(verbose_id, "CLARGS_TEST_EMPTY_VERBOSE");
+
+		std::vector<std::string_view> args;
+		std::vector<std::string_view> non_key;
+		auto error = p.try_parse(utki::make_span(args), non_key);
+
+		tst::check(error.code == clargs::error_code::invalid_value, SL);
+		tst::check_eq(error.argument, "CLARGS_TEST_EMPTY_VERBOSE="sv, SL);
+		tst::check(!verbose, SL);
+
+		unsetenv("CLARGS_TEST_EMPTY_VERBOSE");
+		unsetenv("CLARGS_TEST_EMPTY_OUTPUT");
+	});
+#endif
+});
+}
@@ -0,0 +1,115 @@
+#include <atomic>
+#include <functional>
+#include <thread>
+
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include <clargs/parser.hpp>
+
+using namespace std::string_literals;
+
+namespace{
+const tst::set set("freeze", [](tst::suite& suite){
+	suite.add("adding_argument_to_frozen_parser_throws", []{
+		clargs::parser p;
+
+		p.add('a', "aaa", "description", [](){});
+
+		p.freeze();
+		tst::check(p.is_frozen(), SL);
+
+		bool exception_caught = false;
+		try{
+			p.add('b', "bbb", "description", [](){});
+		}catch(std::logic_error& e){
+			exception_caught = true;
+		}
+		tst::check(exception_caught, SL);
+	});
+
+	suite.add("changing_settings_of_frozen_parser_throws", []{
+		clargs::parser p;
+
+		bool key_parsing_disabled = false;
+		p.add('d', "disable", "description", [&](){
+			// only affects the ongoing parsing, so it is allowed for the frozen parser
+			p.set_key_parsing(false);
+			key_parsing_disabled = true;
+		});
+
+		p.freeze();
+
+		auto check_throws = [](const std::function<void()>& f){
+			try{
+				f();
+			}catch(std::logic_error&){
+				return true;
+			}
+			return false;
+		};
+
+		tst::check(check_throws([&](){p.set_key_parsing(false);}), SL);
+		tst::check(check_throws([&](){p.set_response_files_expansion(true);}), SL);
+		tst::check(check_throws([&](){p.set_key_abbreviations(true);}), SL);
+
+		std::vector<std::string_view> args = {"-d", "-a"};
+		auto non_key = p.parse_views(utki::make_span(args));
+
+		tst::check(key_parsing_disabled, SL);
+		tst::check_eq(non_key.size(), size_t(1), SL);
+
+		// key parsing is enabled again at the beginning of the next parsing
+		args = {"-d", "-d"};
+		non_key = p.parse_views(utki::make_span(args));
+		tst::check_eq(non_key.size(), size_t(1), SL);
+	});
+
+	suite.add("frozen_parser_parses_concurrently", []{
+		clargs::parser p;
+
+		std::atomic<unsigned> a{0};
+		std::atomic<size_t> b{0};
+
+		p.add('a', "aaa", "description", [&a](){++a;});
+		p.add('b', "bbb", "description", [&b](std::string_view v){b += v.size();});
+		p.add('s', "stop", "description", [&p](){p.stop();});
+
+		p.freeze();
+
+		const clargs::parser& cp = p;
+
+		constexpr unsigned num_threads = 4;
+		constexpr unsigned num_iterations = 1000;
+
+		std::vector<std::thread> threads;
+		std::atomic<unsigned> num_failures{0};
+
+		for(unsigned t = 0; t != num_threads; ++t){
+			threads.emplace_back([&cp, &num_failures](){
+				std::vector<std::string_view> args = {
+					"-a",
+					"--bbb=12345",
+					"non-key",
+					"-s",
+					"-a"
+				};
+				for(unsigned i = 0; i != num_iterations; ++i){
+					auto res = cp.parse_views(utki::make_span(args));
+					if(res.size() != 1 || res[0] != "non-key"){
+						++num_failures;
+					}
+				}
+			});
+		}
+
+		for(auto& t : threads){
+			t.join();
+		}
+
+		tst::check_eq(num_failures.load(), unsigned(0), SL);
+		tst::check_eq(a.load(), num_threads * num_iterations, SL) << "a = " << a.load();
+		tst::check_eq(b.load(), size_t(num_threads * num_iterations * 5), SL) << "b = " << b.load();
+	});
+});
+}
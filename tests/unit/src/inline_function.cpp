@@ -0,0 +1,128 @@
+#include <array>
+#include <memory>
+
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include <clargs/parser.hpp>
+
+using namespace std::string_literals;
+
+namespace{
+// counts alive instances of the callable
+struct counted_callable{
+	std::shared_ptr<int> count;
+	std::array<size_t, 8> payload = {}; // does not fit into inline buffer
+
+	explicit counted_callable(std::shared_ptr<int> count) :
+		count(std::move(count))
+	{
+		++*this->count;
+	}
+
+	counted_callable(const counted_callable& c) :
+		count(c.count),
+		payload(c.payload)
+	{
+		++*this->count;
+	}
+
+	counted_callable& operator=(const counted_callable&) = delete;
+
+	~counted_callable(){
+		--*this->count;
+	}
+
+	int operator()(int a){
+		return a + int(this->payload.size());
+	}
+};
+}
+
+namespace{
+const tst::set set("inline_function", [](tst::suite& suite){
+	suite.add("small_and_big_callables_are_called", []{
+		int a = 10;
+		clargs::inline_function<int(int)> small = [&a](int b){ return a + b; };
+
+		std::array<int, 16> big_capture = {};
+		big_capture[15] = 20;
+		clargs::inline_function<int(int)> big = [big_capture](int b){ return big_capture[15] + b; };
+
+		tst::check_eq(small(1), 11, SL);
+		tst::check_eq(big(1), 21, SL);
+
+		auto moved = std::move(big);
+		tst::check(!big, SL);
+		tst::check_eq(moved(2), 22, SL);
+	});
+
+	suite.add("callable_is_destroyed", []{
+		auto count = std::make_shared<int>(0);
+
+		{
+			clargs::inline_function<int(int)> f = counted_callable(count);
+			tst::check_eq(*count, 1, SL);
+
+			clargs::inline_function<int(int)> g = std::move(f);
+			tst::check_eq(*count, 1, SL);
+			tst::check_eq(g(1), 9, SL);
+
+			g = nullptr;
+			tst::check_eq(*count, 0, SL);
+
+			g = clargs::inline_function<int(int)>(counted_callable(count));
+			tst::check_eq(*count, 1, SL);
+		}
+
+		tst::check_eq(*count, 0, SL);
+	});
+
+	suite.add("empty_std_function_gives_empty_inline_function", []{
+		std::function<void()> empty;
+		clargs::inline_function<void()> f = empty;
+		tst::check(!f, SL);
+
+		void (*null_function)() = nullptr;
+		clargs::inline_function<void()> g = null_function;
+		tst::check(!g, SL);
+	});
+
+	suite.add("function_ref_handlers_are_called", []{
+		std::string value;
+		int count = 0;
+
+		auto value_handler = [&value](std::string_view v){ value = v; };
+		auto boolean_handler = [&count](){ ++count; };
+
+		clargs::parser p;
+		p.add("aaa", "value argument", clargs::function_ref<void(std::string_view)>(value_handler));
+		p.add('b', "boolean argument", clargs::function_ref<void()>(boolean_handler));
+
+		std::vector<const char*> args = {"--aaa=hello", "-b", "-b"};
+		p.parse(utki::make_span(args));
+
+		tst::check_eq(value, "hello"s, SL);
+		tst::check_eq(count, 2, SL);
+	});
+
+	suite.add("optional_value_handlers_are_called", []{
+		std::vector<std::string> values;
+
+		clargs::parser p;
+		p.add(
+			"aaa",
+			"optional value argument",
+			[&values](std::string_view v){ values.emplace_back(v); },
+			[&values](){ values.emplace_back("default"); }
+		);
+
+		std::vector<const char*> args = {"--aaa=hello", "--aaa"};
+		p.parse(utki::make_span(args));
+
+		tst::check_eq(values.size(), size_t(2), SL);
+		tst::check_eq(values[0], "hello"s, SL);
+		tst::check_eq(values[1], "default"s, SL);
+	});
+});
+}
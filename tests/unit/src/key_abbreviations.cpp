@@ -0,0 +1,156 @@
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include <clargs/parser.hpp>
+
+using namespace std::string_literals;
+using namespace std::string_view_literals;
+
+namespace{
+const tst::set set("key_abbreviations", [](tst::suite& suite){
+	suite.add("abbreviations_are_disabled_by_default", []{
+		bool verbose = false;
+
+		clargs::parser p;
+		p.add("verbose", "verbose output", verbose);
+
+		std::vector<std::string_view> args = {"--verb"};
+		std::vector<std::string_view> non_key;
+		auto error = p.try_parse(utki::make_span(args), non_key);
+
+		tst::check(error.code == clargs::error_code::unknown_argument, SL);
+		tst::check(!verbose, SL);
+	});
+
+	suite.add("unambiguous_prefix_is_handled_as_the_key", []{
+		bool verbose = false;
+		bool version = false;
+		int level = 0;
+		int verbatim_level = 0;
+
+		clargs::parser p;
+		p.set_key_abbreviations(true);
+		p.add('v', "verbose", "verbose output", verbose);
+		p.add("version", "show version", version);
+		p.add('l', "level", "level", level);
+		p.add("verbatim-level", "level of verbatim output", verbatim_level);
+
+		p.parse("--verbo --l=3"sv);
+		tst::check(verbose, SL);
+		tst::check(!version, SL);
+		tst::check_eq(level, 3, SL);
+
+		p.parse("--verba=4 --vers"sv);
+		tst::check_eq(verbatim_level, 4, SL);
+		tst::check(version, SL);
+	});
+
+	suite.add("non_ascii_keys_are_abbreviated", []{
+		std::vector<std::string> res;
+
+		clargs::parser p;
+		p.set_key_abbreviations(true);
+		p.add("apple", "apple", [&res](){res.emplace_back("apple");});
+		p.add("été", "summer", [&res](){res.emplace_back("summer");});
+		p.add("école", "school", [&res](){res.emplace_back("school");});
+
+		p.parse("--ét --app --éc"sv);
+
+		std::vector<std::string> expected = {"summer", "apple", "school"};
+		tst::check(res == expected, SL);
+	});
+
+	suite.add("exact_key_takes_precedence_over_longer_keys", []{
+		std::vector<std::string> res;
+
+		clargs::parser p;
+		p.set_key_abbreviations(true);
+		p.add("in", "input", [&res](std::string_view v){res.push_back("in = "s.append(v));});
+		p.add("include", "include", [&res](std::string_view v){res.push_back("include = "s.append(v));});
+
+		p.parse("--in=a --inc=b"sv);
+
+		std::vector<std::string> expected = {"in = a", "include = b"};
+		tst::check(res == expected, SL);
+	});
+
+	suite.add("ambiguous_prefix_reports_all_candidates", []{
+		clargs::parser p;
+		p.set_key_abbreviations(true);
+		p.add("verbose", "verbose output", [](){});
+		p.add("version", "show version", [](){});
+		p.add("level", "level", [](){});
+		p.freeze();
+
+		std::vector<std::string_view> args = {"--ver"};
+		std::vector<std::string_view> non_key;
+		auto error = p.try_parse(utki::make_span(args), non_key);
+
+		tst::check(error.code == clargs::error_code::ambiguous_argument, SL);
+		tst::check_eq(error.key, "ver"sv, SL);
+		std::vector<std::string> expected = {"verbose", "version"};
+		tst::check(error.candidates == expected, SL);
+		tst::check_eq(
+			error.message(),
+			"ambiguous argument: --ver, possible keys: --verbose, --version"s,
+			SL
+		);
+
+		bool thrown = false;
+		try{
+			p.parse("--vers --v"sv);
+		}catch(std::invalid_argument&){
+			thrown = true;
+		}
+		tst::check(thrown, SL);
+	});
+
+	suite.add("keys_added_after_lookup_are_abbreviated", []{
+		std::vector<std::string> res;
+
+		clargs::parser p;
+		p.set_key_abbreviations(true);
+		p.add("alpha", "alpha", [&](){
+			res.emplace_back("alpha");
+			p.add("beta", "beta", [&](){res.emplace_back("beta");});
+		});
+
+		p.parse("--al --be"sv);
+
+		std::vector<std::string> expected = {"alpha", "beta"};
+		tst::check(res == expected, SL);
+	});
+
+	suite.add("subcommand_keys_and_parent_keys_are_abbreviated", []{
+		bool force = false;
+		bool verbose = false;
+		bool parent_fast = false;
+		bool sub_fast = false;
+
+		clargs::parser p;
+		p.set_key_abbreviations(true);
+		p.add("verbose", "verbose output", verbose);
+		p.add("fast", "fast", parent_fast);
+		p.add_subcommand("push", [&](clargs::parser& sp){
+			sp.add("force", "force push", force);
+			sp.add("fast", "fast push", sub_fast);
+		});
+
+		// the parent's 'fast' key is shadowed by the sub-parser's one, so the 'f' prefix is ambiguous
+		// only between the sub-parser's keys
+		std::vector<std::string_view> args = {"push", "--verb", "--fo", "--f"};
+		std::vector<std::string_view> non_key;
+		auto error = p.try_parse(utki::make_span(args), non_key);
+
+		tst::check(verbose, SL);
+		tst::check(force, SL);
+		tst::check(error.code == clargs::error_code::ambiguous_argument, SL);
+		std::vector<std::string> expected = {"fast", "force"};
+		tst::check(error.candidates == expected, SL) << "error.candidates.size() = " << error.candidates.size();
+
+		p.parse("push --fa"sv);
+		tst::check(sub_fast, SL);
+		tst::check(!parent_fast, SL);
+	});
+});
+}
@@ -0,0 +1,76 @@
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include <clargs/parser.hpp>
+
+using namespace std::string_literals;
+using namespace std::string_view_literals;
+
+namespace{
+const tst::set set("nul_separated", [](tst::suite& suite){
+	suite.add("nul_separated_arguments_are_parsed", []{
+		clargs::parser p;
+
+		std::vector<std::string> res;
+
+		p.add('a', "aaa", "description", [&res](){res.emplace_back("a");});
+		p.add("bbb", "description", [&res](std::string_view v){res.push_back("b = "s.append(v));});
+		p.add('c', "description", [&res](std::string_view v){res.push_back("c = "s.append(v));});
+
+		auto buffer = "first\0-a\0--bbb=value with spaces\0-c\0\0last\0"sv;
+
+		auto non_key = p.parse_nul_separated(buffer);
+
+		std::vector<std::string> expected = {
+			"a",
+			"b = value with spaces",
+			"c = "
+		};
+		tst::check(res == expected, SL) << "res.size() = " << res.size();
+
+		tst::check_eq(non_key.size(), size_t(2), SL);
+		tst::check_eq(non_key[0], "first"sv, SL);
+		tst::check(non_key[0].data() == buffer.data(), SL);
+		tst::check_eq(non_key[1], "last"sv, SL);
+	});
+
+	suite.add("last_argument_without_terminating_nul", []{
+		clargs::parser p;
+
+		auto non_key = p.parse_nul_separated("first\0second"sv);
+
+		tst::check_eq(non_key.size(), size_t(2), SL);
+		tst::check_eq(non_key[0], "first"sv, SL);
+		tst::check_eq(non_key[1], "second"sv, SL);
+	});
+
+	suite.add("empty_buffer", []{
+		clargs::parser p;
+
+		auto non_key = p.parse_nul_separated(""sv);
+
+		tst::check(non_key.empty(), SL);
+	});
+
+	suite.add("subcommand_gets_remaining_arguments", []{
+		clargs::parser p;
+
+		std::vector<std::string> res;
+		p.add([&res](std::string_view command, utki::span<std::string_view> args){
+			res.emplace_back(command);
+			for(const auto& a : args){
+				res.emplace_back(a);
+			}
+		});
+
+		p.parse_nul_separated("command\0-b\0arg\0"sv);
+
+		std::vector<std::string> expected = {
+			"command",
+			"-b",
+			"arg"
+		};
+		tst::check(res == expected, SL) << "res.size() = " << res.size();
+	});
+});
+}
@@ -0,0 +1,66 @@
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include <clargs/parser.hpp>
+
+using namespace std::string_literals;
+
+namespace{
+const tst::set set("parse_stats", [](tst::suite& suite){
+	suite.add("statistics_are_collected", []{
+		clargs::parser p;
+
+		auto a_id = p.add('a', "aaa", "boolean argument", [](){});
+		auto b_id = p.add('b', "bbb", "boolean argument", [](){});
+		std::string c;
+		auto c_id = p.add("ccc", "value argument", c);
+		auto d_id = p.add('d', "ddd", "unused argument", [](){});
+
+		std::vector<std::string_view> args = {
+			"-a", "--bbb", "-ab", "--ccc=hello", "file1", "file2", "--", "-a"
+		};
+
+		clargs::parse_stats stats;
+		auto non_key = p.parse(utki::make_span(args), stats);
+
+		tst::check_eq(non_key.size(), size_t(3), SL);
+		tst::check_eq(c, "hello"s, SL);
+
+		tst::check_eq(stats.num_arguments, args.size(), SL);
+		tst::check_eq(stats.num_long_keys, size_t(2), SL);
+		tst::check_eq(stats.num_short_keys, size_t(3), SL);
+		tst::check_eq(stats.num_non_keys, size_t(3), SL);
+		tst::check(stats.num_probes >= stats.num_long_keys, SL);
+
+		tst::check_eq(stats.arguments.size(), size_t(4), SL);
+		tst::check_eq(stats.arguments[a_id].num_calls, size_t(2), SL);
+		tst::check_eq(stats.arguments[b_id].num_calls, size_t(2), SL);
+		tst::check_eq(stats.arguments[c_id].num_calls, size_t(1), SL);
+		tst::check_eq(stats.arguments[d_id].num_calls, size_t(0), SL);
+		tst::check_eq(stats.non_key.num_calls, size_t(3), SL);
+		tst::check_eq(stats.subcommand.num_calls, size_t(0), SL);
+
+		tst::check(stats.time >= stats.arguments[a_id].time + stats.non_key.time, SL);
+	});
+
+	suite.add("subcommand_is_counted_as_a_whole", []{
+		bool a = false;
+
+		clargs::parser p;
+		p.add_subcommand("run", [&a](clargs::parser& sp){
+			sp.add('a', "aaa", "boolean argument", [&a](){ a = true; });
+		});
+
+		std::vector<std::string_view> args = {"run", "-a", "file"};
+
+		clargs::parse_stats stats;
+		auto non_key = p.parse(utki::make_span(args), stats);
+
+		tst::check(a, SL);
+		tst::check_eq(non_key.size(), size_t(1), SL);
+		tst::check_eq(stats.subcommand.num_calls, size_t(1), SL);
+		tst::check_eq(stats.num_short_keys, size_t(0), SL);
+		tst::check_eq(stats.num_non_keys, size_t(0), SL);
+	});
+});
+}
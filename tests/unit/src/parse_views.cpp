@@ -0,0 +1,55 @@
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include <clargs/parser.hpp>
+
+using namespace std::string_view_literals;
+
+namespace{
+const tst::set set("parse_views", [](tst::suite& suite){
+	suite.add("non_key_arguments_are_views_into_input", []{
+		clargs::parser p;
+
+		unsigned a = 0;
+
+		p.add('a', "aaa", "description", [&a](){++a;});
+
+		std::vector<std::string_view> args = {
+			"-a",
+			"hello",
+			"--aaa",
+			"world"
+		};
+
+		auto res = p.parse_views(utki::make_span(args));
+
+		tst::check_eq(a, unsigned(2), SL) << "a = " << a;
+		tst::check_eq(res.size(), size_t(2), SL) << "res.size() = " << res.size();
+		tst::check_eq(res[0], "hello"sv, SL) << "res[0] = " << res[0];
+		tst::check_eq(res[1], "world"sv, SL) << "res[1] = " << res[1];
+		tst::check(res[0].data() == args[1].data(), SL);
+		tst::check(res[1].data() == args[3].data(), SL);
+	});
+
+	suite.add("non_key_arguments_are_views_into_argv", []{
+		clargs::parser p;
+
+		std::string_view value;
+
+		p.add('v', "value", "description", [&value](std::string_view v){value = v;});
+
+		std::vector<const char*> args = {
+			"-v",
+			"val",
+			"hello"
+		};
+
+		auto res = p.parse_views(utki::make_span(args));
+
+		tst::check_eq(value, "val"sv, SL) << "value = " << value;
+		tst::check(value.data() == args[1], SL);
+		tst::check_eq(res.size(), size_t(1), SL) << "res.size() = " << res.size();
+		tst::check(res[0].data() == args[2], SL);
+	});
+});
+}
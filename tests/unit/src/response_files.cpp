@@ -0,0 +1,167 @@
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include <clargs/parser.hpp>
+
+#include "temp_file.hpp"
+
+using namespace std::string_literals;
+
+namespace{
+const tst::set set("response_files", [](tst::suite& suite){
+	suite.add("response_file_is_expanded", []{
+		temp_file file("clargs_test_response_file_1.txt", "-a \"double quoted\" 'single quoted'\n\tescaped\\ space --bbb=\"b \\\"val\\\"\" -c\ntrailing\n");
+
+		clargs::parser p;
+		p.set_response_files_expansion(true);
+
+		std::vector<std::string> res;
+
+		p.add('a', "aaa", "description", [&res](){res.emplace_back("a");});
+		p.add("bbb", "description", [&res](std::string_view v){res.push_back("b = "s.append(v));});
+		p.add('c', "description", [&res](std::string_view v){res.push_back("c = "s.append(v));});
+
+		std::vector<std::string_view> args = {
+			"first",
+			"@clargs_test_response_file_1.txt",
+			"last"
+		};
+
+		auto non_key = p.parse(utki::make_span(args));
+
+		std::vector<std::string> expected = {
+			"a",
+			"b = b \"val\"",
+			"c = trailing"
+		};
+		tst::check(res == expected, SL) << "res.size() = " << res.size();
+
+		std::vector<std::string> expected_non_key = {
+			"first",
+			"double quoted",
+			"single quoted",
+			"escaped space",
+			"last"
+		};
+		tst::check(non_key == expected_non_key, SL) << "non_key.size() = " << non_key.size();
+	});
+
+	suite.add("nested_response_files_are_expanded", []{
+		temp_file file1("clargs_test_response_file_2.txt", "-a @clargs_test_response_file_3.txt two");
+		temp_file file2("clargs_test_response_file_3.txt", "one -a");
+
+		clargs::parser p;
+		p.set_response_files_expansion(true);
+
+		unsigned a = 0;
+		p.add('a', "aaa", "description", [&a](){++a;});
+
+		std::vector<std::string> res;
+		p.add([&res](std::string_view v){res.emplace_back(v);});
+
+		std::vector<std::string_view> args = {
+			"@clargs_test_response_file_2.txt",
+			"three"
+		};
+
+		p.parse(utki::make_span(args));
+
+		tst::check_eq(a, unsigned(2), SL) << "a = " << a;
+
+		std::vector<std::string> expected = {
+			"one",
+			"two",
+			"three"
+		};
+		tst::check(res == expected, SL) << "res.size() = " << res.size();
+	});
+
+	suite.add("response_files_expansion_is_disabled_by_default", []{
+		clargs::parser p;
+
+		std::vector<std::string_view> args = {
+			"@some_file"
+		};
+
+		auto res = p.parse(utki::make_span(args));
+
+		tst::check_eq(res.size(), size_t(1), SL) << "res.size() = " << res.size();
+		tst::check_eq(res[0], "@some_file"s, SL) << "res[0] = " << res[0];
+	});
+
+	suite.add("unterminated_quote_in_response_file", []{
+		temp_file file("clargs_test_response_file_4.txt", "one \"two");
+
+		clargs::parser p;
+		p.set_response_files_expansion(true);
+
+		std::vector<std::string_view> args = {
+			"@clargs_test_response_file_4.txt"
+		};
+
+		bool exception_caught = false;
+		try{
+			p.parse(utki::make_span(args));
+		}catch(std::invalid_argument& e){
+			exception_caught = true;
+		}
+		tst::check(exception_caught, SL);
+	});
+
+	suite.add("try_parse_error_in_response_file", []{
+		temp_file file("clargs_test_response_file_5.txt", "-a --unknown-key");
+
+		clargs::parser p;
+		p.set_response_files_expansion(true);
+		p.add('a', "description", [](){});
+
+		std::vector<std::string_view> args = {
+			"first",
+			"@clargs_test_response_file_5.txt"
+		};
+
+		std::vector<std::string_view> non_key;
+		auto error = p.try_parse(utki::make_span(args), non_key);
+
+		tst::check(error.code == clargs::error_code::unknown_argument, SL);
+		tst::check_eq(error.argument_index, size_t(1), SL);
+		tst::check_eq(error.argument, std::string_view("--unknown-key"), SL);
+		tst::check_eq(error.message(), "unknown argument: --unknown-key"s, SL);
+	});
+
+	suite.add("try_parse_error_in_subcommand_from_response_file", []{
+		temp_file file("clargs_test_response_file_6.txt", "push -f --unknown-key-of-subcommand");
+
+		clargs::parser p;
+		p.set_response_files_expansion(true);
+		p.add_subcommand("push", [](clargs::parser& sp){
+			sp.add('f', "force", "force push", [](){});
+		});
+
+		std::vector<std::string_view> args = {
+			"@clargs_test_response_file_6.txt",
+			"--unknown-key-after-response-file"
+		};
+
+		std::vector<std::string_view> non_key;
+		auto error = p.try_parse(utki::make_span(args), non_key);
+
+		// the error refers to the response file contents, which has to be kept mapped by the error
+		tst::check(error.code == clargs::error_code::unknown_argument, SL);
+		tst::check_eq(error.argument_index, size_t(0), SL);
+		tst::check_eq(error.argument, std::string_view("--unknown-key-of-subcommand"), SL);
+		tst::check_eq(error.message(), "unknown argument: --unknown-key-of-subcommand"s, SL);
+
+		// the arguments following the response file keep their indices
+		temp_file valid_file("clargs_test_response_file_7.txt", "push -f");
+
+		args.front() = "@clargs_test_response_file_7.txt";
+
+		error = p.try_parse(utki::make_span(args), non_key);
+
+		tst::check(error.code == clargs::error_code::unknown_argument, SL);
+		tst::check_eq(error.argument_index, size_t(1), SL);
+		tst::check_eq(error.argument, std::string_view("--unknown-key-after-response-file"), SL);
+	});
+});
+}
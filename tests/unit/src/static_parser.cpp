@@ -0,0 +1,150 @@
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include <clargs/parser.hpp>
+#include <clargs/static_parser.hpp>
+
+using namespace std::string_literals;
+using namespace std::string_view_literals;
+
+namespace{
+constexpr std::array<clargs::option, 5> options = {{
+	{'a', "aaa", "boolean argument with short and long keys"},
+	{'b', "", "value argument with only short key", clargs::value_kind::required},
+	{'\0', "ccc", "value argument with only long key, it has a long description which does not fit into one line", clargs::value_kind::required},
+	{'\0', "optional-value-argument-with-long-key", "argument with optional value", clargs::value_kind::optional},
+	{'e', "eee", "value argument with short and long keys", clargs::value_kind::required}
+}};
+
+constexpr clargs::static_parser parser(options);
+
+static_assert(parser.find('a') == 0);
+static_assert(parser.find('c') == clargs::static_parser<options.size()>::npos);
+static_assert(parser.find("ccc"sv) == 2);
+static_assert(parser.find("eee"sv) == 4);
+static_assert(parser.find("bbb"sv) == clargs::static_parser<options.size()>::npos);
+
+constexpr auto help = clargs::make_description<options>();
+
+constexpr std::array<clargs::option, 3> wrapping_options = {{
+	{'a', "aaa", "some_very_long_word_which_is_longer_than_the_width short words"},
+	{'b', "bbb", "multiple\nlines  with two spaces", clargs::value_kind::required},
+	{'c', "ccc", ""}
+}};
+
+constexpr auto wrapping_help = clargs::make_description<wrapping_options, 12, 20>();
+constexpr auto zero_width_help = clargs::make_description<wrapping_options, 12, 0>();
+}
+
+namespace{
+const tst::set set("static_parser", [](tst::suite& suite){
+	suite.add("parse", []{
+		std::vector<std::string> res;
+
+		std::vector<std::string_view> args = {
+			"-ab",
+			"b_val",
+			"non-key",
+			"--ccc=c_val",
+			"--optional-value-argument-with-long-key",
+			"--optional-value-argument-with-long-key=o_val",
+			"-aee_val",
+			"--",
+			"-a"
+		};
+
+		parser.parse(
+			utki::make_span(args),
+			[&res](size_t index, std::optional<std::string_view> value){
+				res.push_back(std::to_string(index) + " = " + (value ? std::string(*value) : "none"s));
+			},
+			[&res](std::string_view arg){
+				res.push_back("non-key = "s.append(arg));
+			}
+		);
+
+		std::vector<std::string> expected = {
+			"0 = none",
+			"1 = b_val",
+			"non-key = non-key",
+			"2 = c_val",
+			"3 = none",
+			"3 = o_val",
+			"0 = none",
+			"4 = e_val",
+			"non-key = -a"
+		};
+
+		tst::check(res == expected, SL) << "res.size() = " << res.size();
+	});
+
+	suite.add("parse_unknown_argument", []{
+		std::vector<const char*> args = {
+			"-a",
+			"--ddd"
+		};
+
+		bool exception_caught = false;
+		try{
+			parser.parse(utki::make_span(args), [](size_t, std::optional<std::string_view>){}, [](std::string_view){});
+		}catch(std::invalid_argument& e){
+			exception_caught = true;
+			tst::check_eq(std::string(e.what()), "unknown argument: --ddd"s, SL) << "e.what() = " << e.what();
+		}
+		tst::check(exception_caught, SL);
+	});
+
+	suite.add("description_is_same_as_of_parser", []{
+		clargs::parser p;
+
+		p.add('a', "aaa", "boolean argument with short and long keys", [](){});
+		p.add('b', "value argument with only short key", [](std::string_view){});
+		p.add("ccc", "value argument with only long key, it has a long description which does not fit into one line", [](std::string_view){});
+		p.add("optional-value-argument-with-long-key", "argument with optional value", [](std::string_view){}, [](){});
+		p.add('e', "eee", "value argument with short and long keys", [](std::string_view){});
+
+		auto description = std::string(help.data(), help.size());
+
+		tst::check_eq(description, p.description(), SL) << "description =\n" << description << "\nexpected =\n" << p.description();
+	});
+
+	suite.add("description_with_long_words_and_zero_width_is_same_as_of_parser", []{
+		clargs::parser p;
+
+		p.add('a', "aaa", "some_very_long_word_which_is_longer_than_the_width short words", [](){});
+		p.add('b', "bbb", "multiple\nlines  with two spaces", [](std::string_view){});
+		p.add('c', "ccc", "", [](){});
+
+		auto description = std::string(wrapping_help.data(), wrapping_help.size());
+
+		auto expected =
+			"  -a, --aaa   some_very_long_word_which_is_longer_than_the_width\n"
+			"              short words\n"
+			"  -b, --bbb=VALUE\n"
+			"              multiple\n"
+			"              lines  with two\n"
+			"              spaces\n"
+			"  -c, --ccc   \n"s;
+
+		tst::check_eq(description, expected, SL) << "description =\n" << description;
+		tst::check_eq(p.description(12, 20), expected, SL) << "description =\n" << p.description(12, 20);
+
+		description = std::string(zero_width_help.data(), zero_width_help.size());
+
+		expected =
+			"  -a, --aaa   some_very_long_word_which_is_longer_than_the_width\n"
+			"              short\n"
+			"              words\n"
+			"  -b, --bbb=VALUE\n"
+			"              multiple\n"
+			"              lines\n"
+			"              with\n"
+			"              two\n"
+			"              spaces\n"
+			"  -c, --ccc   \n"s;
+
+		tst::check_eq(description, expected, SL) << "description =\n" << description;
+		tst::check_eq(p.description(12, 0), expected, SL) << "description =\n" << p.description(12, 0);
+	});
+});
+}
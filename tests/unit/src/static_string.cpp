@@ -0,0 +1,81 @@
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include <clargs/parser.hpp>
+
+using namespace std::string_literals;
+using namespace clargs::literals;
+
+namespace{
+static_assert(clargs::string_arg("aaa"_static).is_static(), "static_string must be static");
+static_assert(!clargs::string_arg("aaa").is_static(), "string literal must not be static unless marked");
+static_assert(clargs::string_arg("aaa"_static).view() == "aaa", "static_string must refer to the literal");
+
+const tst::set set("static_string", [](tst::suite& suite){
+	suite.add("static_keys_and_descriptions_are_used", []{
+		bool a = false;
+		std::string b;
+		std::string c;
+
+		clargs::parser p;
+		p.add('a', "aaa"_static, "boolean argument"_static, [&a](){ a = true; });
+		p.add("bbb"_static, "value argument"_static, [&b](std::string_view v){ b = v; });
+		p.add('c', "short only argument"_static, c);
+
+		std::vector<const char*> args = {"--aaa", "--bbb=hello", "-c", "world"};
+		p.parse(utki::make_span(args));
+
+		tst::check(a, SL);
+		tst::check_eq(b, "hello"s, SL);
+		tst::check_eq(c, "world"s, SL);
+
+		auto expected =
+				"  -a, --aaa   boolean argument\n"
+				"      --bbb=VALUE\n"
+				"              value argument\n"
+				"  -c VALUE    short only argument\n"s;
+
+		tst::check_eq(p.description(12), expected, SL) << "description =\n" << p.description(12);
+	});
+
+	suite.add("static_and_copied_strings_can_be_mixed", []{
+		bool a = false;
+
+		clargs::parser p;
+
+		{
+			// the copied strings do not need to outlive the registration
+			auto description = "boolean argument"s;
+			p.add("aaa"_static, description, [&a](){ a = true; });
+		}
+
+		bool thrown = false;
+		try{
+			p.add("aaa"s, "duplicate"_static, [](){});
+		}catch(std::logic_error&){
+			thrown = true;
+		}
+		tst::check(thrown, SL);
+
+		std::vector<const char*> args = {"--aaa"};
+		p.parse(utki::make_span(args));
+
+		tst::check(a, SL);
+		tst::check(p.description().find("boolean argument") != std::string::npos, SL);
+	});
+
+	suite.add("static_subcommand_name_is_used", []{
+		bool a = false;
+
+		clargs::parser p;
+		p.add_subcommand("run"_static, [&a](clargs::parser& sp){
+			sp.add('a', "aaa"_static, "boolean argument"_static, [&a](){ a = true; });
+		});
+
+		std::vector<const char*> args = {"run", "-a"};
+		p.parse(utki::make_span(args));
+
+		tst::check(a, SL);
+	});
+});
+}
@@ -0,0 +1,128 @@
+#include <sstream>
+
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include <utki/config.hpp>
+
+#if CFG_OS != CFG_OS_WINDOWS
+#	include <unistd.h>
+#endif
+
+#include <clargs/parser.hpp>
+
+using namespace std::string_literals;
+
+namespace{
+const tst::set set("stream", [](tst::suite& suite){
+	suite.add("arguments_are_read_from_stream", []{
+		// small buffer sizes make the arguments split across the reads
+		for(size_t buffer_size : {1, 2, 3, 5, 8, 0x10000}){
+			clargs::parser p;
+
+			std::vector<std::string> res;
+
+			p.add('a', "aaa", "description", [&res](){res.emplace_back("a");});
+			p.add("bbb", "description", [&res](std::string_view v){res.push_back("b = "s.append(v));});
+			p.add('c', "description", [&res](std::string_view v){res.push_back("c = "s.append(v));});
+
+			std::istringstream input("first\n-ac\nvalue of c\n--bbb=some long value\n\n-cvalue\nlast");
+
+			auto non_key = p.parse(input, '\n', buffer_size);
+
+			std::vector<std::string> expected = {
+				"a",
+				"c = value of c",
+				"b = some long value",
+				"c = value"
+			};
+			tst::check(res == expected, SL) << "buffer_size = " << buffer_size << ", res.size() = " << res.size();
+
+			std::vector<std::string> expected_non_key = {
+				"first",
+				"",
+				"last"
+			};
+			tst::check(non_key == expected_non_key, SL) << "buffer_size = " << buffer_size << ", non_key.size() = " << non_key.size();
+		}
+	});
+
+	suite.add("nul_delimited_stream", []{
+		clargs::parser p;
+
+		std::string value;
+		p.add('a', "description", [&value](std::string_view v){value = v;});
+
+		std::istringstream input(std::string("-a\0multi\nline\0last\0", 19));
+
+		auto non_key = p.parse(input, '\0', 4);
+
+		tst::check_eq(value, "multi\nline"s, SL);
+		tst::check_eq(non_key.size(), size_t(1), SL);
+		tst::check_eq(non_key[0], "last"s, SL);
+	});
+
+	suite.add("subcommand_gets_remaining_arguments", []{
+		clargs::parser p;
+
+		std::vector<std::string> res;
+		p.add([&res](std::string_view command, utki::span<std::string_view> args){
+			res.emplace_back(command);
+			for(const auto& a : args){
+				res.emplace_back(a);
+			}
+		});
+
+		std::istringstream input("command\n-b\nsome argument\n");
+
+		p.parse(input, '\n', 2);
+
+		std::vector<std::string> expected = {
+			"command",
+			"-b",
+			"some argument"
+		};
+		tst::check(res == expected, SL) << "res.size() = " << res.size();
+	});
+
+	suite.add("missing_value_error", []{
+		clargs::parser p;
+
+		p.add('c', "description", [](std::string_view){});
+
+		std::istringstream input("first\n-c");
+
+		bool exception_caught = false;
+		try{
+			p.parse(input, '\n', 2);
+		}catch(std::invalid_argument& e){
+			exception_caught = true;
+			tst::check_eq(e.what(), "argument 'c' requires value"s, SL);
+		}
+		tst::check(exception_caught, SL);
+	});
+
+#if CFG_OS != CFG_OS_WINDOWS
+	suite.add("arguments_are_read_from_file_descriptor", []{
+		clargs::parser p;
+
+		std::string value;
+		p.add('a', "description", [&value](std::string_view v){value = v;});
+
+		int fds[2];
+		tst::check_eq(pipe(fds), 0, SL);
+
+		auto data = "-a\nvalue\nnon-key\n"s;
+		tst::check_eq(write(fds[1], data.data(), data.size()), ssize_t(data.size()), SL);
+		close(fds[1]);
+
+		auto non_key = p.parse_fd(fds[0], '\n', 3);
+		close(fds[0]);
+
+		tst::check_eq(value, "value"s, SL);
+		tst::check_eq(non_key.size(), size_t(1), SL);
+		tst::check_eq(non_key[0], "non-key"s, SL);
+	});
+#endif
+});
+}
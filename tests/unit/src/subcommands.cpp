@@ -0,0 +1,165 @@
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include <clargs/parser.hpp>
+
+using namespace std::string_literals;
+using namespace std::string_view_literals;
+
+namespace{
+const tst::set set("subcommands", [](tst::suite& suite){
+	suite.add("only_invoked_subcommand_is_constructed", []{
+		clargs::parser p;
+
+		std::vector<std::string> res;
+
+		p.add('v', "verbose", "description", [&res](){res.emplace_back("verbose");});
+
+		p.add_subcommand("build", [&res](clargs::parser& sp){
+			res.emplace_back("build constructed");
+			sp.add('j', "jobs", "description", [&res](std::string_view v){res.push_back("jobs = "s.append(v));});
+		});
+		p.add_subcommand("clean", [&res](clargs::parser& sp){
+			res.emplace_back("clean constructed");
+			sp.add('a', "all", "description", [&res](){res.emplace_back("all");});
+		});
+
+		p.freeze();
+
+		std::vector<std::string_view> args = {"-v", "build", "-j4", "target", "--verbose", "other"};
+
+		auto non_key = p.parse(utki::make_span(args));
+
+		std::vector<std::string> expected = {
+			"verbose",
+			"build constructed",
+			"jobs = 4",
+			"verbose"
+		};
+		tst::check(res == expected, SL) << "res.size() = " << res.size();
+
+		std::vector<std::string> expected_non_key = {
+			"target",
+			"other"
+		};
+		tst::check(non_key == expected_non_key, SL) << "non_key.size() = " << non_key.size();
+	});
+
+	suite.add("subcommand_arguments_override_global_ones", []{
+		clargs::parser p;
+
+		std::vector<std::string> res;
+
+		p.add('a', "aaa", "description", [&res](){res.emplace_back("global a");});
+
+		p.add_subcommand("cmd", [&res](clargs::parser& sp){
+			sp.add('a', "aaa", "description", [&res](){res.emplace_back("cmd a");});
+		});
+
+		std::vector<std::string_view> args = {"-a", "cmd", "--aaa", "-a"};
+
+		p.parse(utki::make_span(args));
+
+		std::vector<std::string> expected = {
+			"global a",
+			"cmd a",
+			"cmd a"
+		};
+		tst::check(res == expected, SL) << "res.size() = " << res.size();
+	});
+
+	suite.add("unknown_subcommand_falls_back_to_subcommand_handler", []{
+		clargs::parser p;
+
+		std::string command;
+
+		p.add_subcommand("cmd", [](clargs::parser& sp){});
+		p.add([&command](std::string_view c, utki::span<std::string_view> args){command = c;});
+
+		std::vector<std::string_view> args = {"other", "-x"};
+
+		p.parse(utki::make_span(args));
+
+		tst::check_eq(command, "other"s, SL);
+	});
+
+	suite.add("unknown_subcommand_error", []{
+		clargs::parser p;
+
+		p.add_subcommand("cmd", [](clargs::parser& sp){});
+
+		std::vector<std::string_view> args = {"other"};
+
+		std::vector<std::string_view> non_key;
+		auto error = p.try_parse(utki::make_span(args), non_key);
+
+		tst::check(error.code == clargs::error_code::unknown_subcommand, SL);
+		tst::check_eq(error.message(), "unknown subcommand: other"s, SL);
+	});
+
+	suite.add("error_in_subcommand_arguments", []{
+		clargs::parser p;
+
+		p.add('a', "description", [](){});
+		p.add_subcommand("cmd", [](clargs::parser& sp){
+			sp.add('b', "description", [](){});
+		});
+
+		std::vector<std::string_view> args = {"-a", "cmd", "-b", "-c"};
+
+		std::vector<std::string_view> non_key;
+		auto error = p.try_parse(utki::make_span(args), non_key);
+
+		tst::check(error.code == clargs::error_code::unknown_argument, SL);
+		tst::check_eq(error.argument_index, size_t(3), SL);
+		tst::check_eq(error.message(), "unknown argument: -c"s, SL);
+	});
+
+	suite.add("duplicate_subcommand", []{
+		clargs::parser p;
+
+		p.add_subcommand("cmd", [](clargs::parser& sp){});
+
+		bool exception_caught = false;
+		try{
+			p.add_subcommand("cmd", [](clargs::parser& sp){});
+		}catch(std::logic_error& e){
+			exception_caught = true;
+			tst::check_eq(e.what(), "subcommand 'cmd' already exists"s, SL);
+		}
+		tst::check(exception_caught, SL);
+	});
+
+	suite.add("global_handler_disables_key_parsing_of_subcommand", []{
+		clargs::parser p;
+
+		bool x = false;
+
+		p.add("", "disable key parsing", [&p](){p.set_key_parsing(false);});
+		p.add_subcommand("run", [&x](clargs::parser& sp){
+			sp.add('x', "description", [&x](){x = true;});
+		});
+
+		auto non_key = p.parse("run -- -x"sv);
+
+		tst::check(!x, SL);
+		tst::check_eq(non_key.size(), size_t(1), SL);
+		tst::check_eq(non_key.front(), "-x"s, SL);
+	});
+
+	suite.add("global_handler_stops_subcommand_parsing", []{
+		clargs::parser p;
+
+		bool x = false;
+
+		p.add('v', "description", [&p](){p.stop();});
+		p.add_subcommand("run", [&x](clargs::parser& sp){
+			sp.add('x', "description", [&x](){x = true;});
+		});
+
+		p.parse("run -v -x"sv);
+
+		tst::check(!x, SL);
+	});
+});
+}
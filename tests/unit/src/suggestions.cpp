@@ -0,0 +1,144 @@
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include <clargs/parser.hpp>
+
+using namespace std::string_literals;
+using namespace std::string_view_literals;
+
+namespace{
+std::string parse_error_message(const clargs::parser& p, std::vector<std::string_view> args){
+	try{
+		p.parse(utki::make_span(args));
+	}catch(std::invalid_argument& e){
+		return e.what();
+	}
+	return {};
+}
+}
+
+namespace{
+const tst::set set("suggestions", [](tst::suite& suite){
+	suite.add("closest_key_is_suggested", []{
+		clargs::parser p;
+		p.add('v', "verbose", "verbose output", [](){});
+		p.add("version", "show version", [](){});
+		p.add('l', "level", "level", [](std::string_view){});
+
+		tst::check(p.suggest("verbsoe") == std::vector<std::string>{"verbose"}, SL);
+		tst::check(p.suggest("levle") == std::vector<std::string>{"level"}, SL);
+
+		tst::check_eq(
+			parse_error_message(p, {"--verbsoe"}),
+			"unknown argument: --verbsoe, did you mean --verbose?"s,
+			SL
+		);
+		tst::check_eq(
+			parse_error_message(p, {"--levle=3"}),
+			"unknown argument: --levle=3, did you mean --level?"s,
+			SL
+		);
+
+		bool thrown = false;
+		try{
+			p.parse("--vrebose"sv);
+		}catch(std::invalid_argument& e){
+			thrown = true;
+			tst::check_eq(std::string(e.what()), "unknown argument: --vrebose, did you mean --verbose?"s, SL);
+		}
+		tst::check(thrown, SL);
+	});
+
+	suite.add("try_parse_does_not_look_for_similar_keys", []{
+		clargs::parser p;
+		p.add('v', "verbose", "verbose output", [](){});
+		p.add("version", "show version", [](){});
+
+		std::vector<std::string_view> args = {"--verbsoe"};
+		std::vector<std::string_view> non_key;
+		auto error = p.try_parse(utki::make_span(args), non_key);
+
+		tst::check(error.code == clargs::error_code::unknown_argument, SL);
+		tst::check(error.suggestions.empty(), SL);
+		tst::check_eq(error.key, "verbsoe"sv, SL);
+		tst::check_eq(error.message(), "unknown argument: --verbsoe"s, SL);
+
+		// the suggestions can be requested separately
+		tst::check(p.suggest(error.key) == std::vector<std::string>{"verbose"}, SL);
+	});
+
+	suite.add("equally_close_keys_are_suggested", []{
+		clargs::parser p;
+		p.add("verbose", "verbose output", [](){});
+		p.add("version", "show version", [](){});
+
+		auto suggestions = p.suggest("versoe");
+
+		std::vector<std::string> expected = {"verbose", "version"};
+		tst::check(suggestions == expected, SL) << "suggestions.size() = " << suggestions.size();
+		tst::check_eq(
+			parse_error_message(p, {"--versoe"}),
+			"unknown argument: --versoe, did you mean one of --verbose, --version?"s,
+			SL
+		);
+	});
+
+	suite.add("dissimilar_keys_are_not_suggested", []{
+		clargs::parser p;
+		p.add("verbose", "verbose output", [](){});
+		p.add('a', "ab", "ab", [](){});
+
+		tst::check(p.suggest("output").empty(), SL);
+		tst::check(p.suggest("xy").empty(), SL);
+		tst::check(p.suggest("").empty(), SL);
+
+		tst::check_eq(parse_error_message(p, {"--output"}), "unknown argument: --output"s, SL);
+
+		// the first key of the batch is known, so it is not a long key given with one dash
+		tst::check_eq(parse_error_message(p, {"-axb"}), "unknown argument: -axb"s, SL);
+	});
+
+	suite.add("closest_key_is_found_among_many_similar_keys", []{
+		clargs::parser p;
+		for(size_t i = 0; i != 300; ++i){
+			p.add("option-number-" + std::to_string(i), "option", [](std::string_view){});
+		}
+		p.add("option-numbers", "option", [](){});
+
+		tst::check(p.suggest("otpion-number-150") == std::vector<std::string>{"option-number-150"}, SL);
+		tst::check(p.suggest("option-nubmer-29") == std::vector<std::string>{"option-number-29"}, SL);
+		tst::check(p.suggest("option-numbres") == std::vector<std::string>{"option-numbers"}, SL);
+	});
+
+	suite.add("long_key_given_with_one_dash_is_suggested", []{
+		clargs::parser p;
+		p.add('v', "verbose", "verbose output", [](){});
+		p.add("output", "output file", [](std::string_view){});
+
+		tst::check_eq(
+			parse_error_message(p, {"-output=file"}),
+			"unknown argument: -output=file, did you mean --output?"s,
+			SL
+		);
+	});
+
+	suite.add("parent_parser_keys_are_suggested", []{
+		clargs::parser p;
+		p.add("verbose", "verbose output", [](){});
+		p.add_subcommand("push", [](clargs::parser& sp){
+			sp.add("force", "force push", [](){});
+		});
+
+		tst::check_eq(
+			parse_error_message(p, {"push", "--verbos"}),
+			"unknown argument: --verbos, did you mean --verbose?"s,
+			SL
+		);
+		tst::check_eq(
+			parse_error_message(p, {"push", "--froce"}),
+			"unknown argument: --froce, did you mean --force?"s,
+			SL
+		);
+	});
+});
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+// File with the given contents, which is removed when the object is destroyed.
+class temp_file{
+public:
+	const std::string path;
+
+	temp_file(std::string path, std::string_view contents) :
+		path(std::move(path))
+	{
+		std::ofstream f(this->path, std::ios::binary);
+		f << contents;
+	}
+
+	temp_file(const temp_file&) = delete;
+	temp_file& operator=(const temp_file&) = delete;
+
+	~temp_file(){
+		std::remove(this->path.c_str());
+	}
+};
@@ -0,0 +1,147 @@
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include <clargs/parser.hpp>
+
+using namespace std::string_literals;
+using namespace std::string_view_literals;
+
+namespace{
+const tst::set set("tokens", [](tst::suite& suite){
+	suite.add("ids_are_assigned_in_registration_order", []{
+		clargs::parser p;
+
+		auto a = p.add('a', "description", [](){});
+		auto b = p.add("bbb", "description", clargs::value_kind::required);
+		auto c = p.add('c', "ccc", "description", clargs::value_kind::none);
+
+		tst::check_eq(a, size_t(0), SL);
+		tst::check_eq(b, size_t(1), SL);
+		tst::check_eq(c, size_t(2), SL);
+	});
+
+	suite.add("tokens_are_read", []{
+		clargs::parser p;
+
+		bool handler_called = false;
+
+		auto a = p.add('a', "description", [&handler_called](){handler_called = true;});
+		auto b = p.add('b', "bbb", "description", clargs::value_kind::required);
+		auto c = p.add("ccc", "description", clargs::value_kind::optional);
+		auto d = p.add('d', "description", clargs::value_kind::none);
+
+		std::vector<std::string_view> args = {
+			"-ad",
+			"first",
+			"--bbb=value 1",
+			"-dbvalue2",
+			"-b",
+			"value3",
+			"--ccc",
+			"--ccc=",
+			"--",
+			"-a"
+		};
+
+		std::vector<clargs::parser::token> expected = {
+			{clargs::parser::token_kind::key, a, false, ""},
+			{clargs::parser::token_kind::key, d, false, ""},
+			{clargs::parser::token_kind::non_key, clargs::parser::npos, true, "first"},
+			{clargs::parser::token_kind::key, b, true, "value 1"},
+			{clargs::parser::token_kind::key, d, false, ""},
+			{clargs::parser::token_kind::key, b, true, "value2"},
+			{clargs::parser::token_kind::key, b, true, "value3"},
+			{clargs::parser::token_kind::key, c, false, ""},
+			{clargs::parser::token_kind::key, c, true, ""},
+			{clargs::parser::token_kind::non_key, clargs::parser::npos, true, "-a"}
+		};
+
+		auto tokens = p.tokens(utki::make_span(args));
+
+		size_t i = 0;
+		for(const auto& t : tokens){
+			tst::check(i < expected.size(), SL) << "i = " << i;
+			const auto& e = expected[i];
+			tst::check(t.kind == e.kind, SL) << "i = " << i;
+			tst::check_eq(t.id, e.id, SL) << "i = " << i;
+			tst::check_eq(t.has_value, e.has_value, SL) << "i = " << i;
+			tst::check_eq(t.value, e.value, SL) << "i = " << i;
+			++i;
+		}
+
+		tst::check_eq(i, expected.size(), SL);
+		tst::check(!tokens.error(), SL);
+		tst::check(!handler_called, SL);
+	});
+
+	suite.add("subcommand_token_and_remaining_arguments", []{
+		clargs::parser p;
+
+		auto a = p.add('a', "description", clargs::value_kind::none);
+		p.add([](std::string_view command, utki::span<std::string_view> args){});
+
+		std::vector<std::string_view> args = {"-a", "command", "-b", "arg"};
+
+		auto tokens = p.tokens(utki::make_span(args));
+
+		clargs::parser::token t;
+
+		tst::check(tokens.next(t), SL);
+		tst::check(t.kind == clargs::parser::token_kind::key, SL);
+		tst::check_eq(t.id, a, SL);
+
+		tst::check(tokens.next(t), SL);
+		tst::check(t.kind == clargs::parser::token_kind::subcommand, SL);
+		tst::check_eq(t.value, "command"sv, SL);
+
+		tst::check(!tokens.next(t), SL);
+
+		auto remaining = tokens.remaining();
+		tst::check_eq(remaining.size(), size_t(2), SL);
+		tst::check_eq(remaining[0], "-b"sv, SL);
+		tst::check_eq(remaining[1], "arg"sv, SL);
+	});
+
+	suite.add("key_parsing_can_be_disabled_while_reading", []{
+		clargs::parser p;
+
+		p.add('a', "description", clargs::value_kind::none);
+		auto stop = p.add("stop", "description", clargs::value_kind::none);
+
+		std::vector<std::string_view> args = {"-a", "--stop", "-a"};
+
+		auto tokens = p.tokens(utki::make_span(args));
+
+		std::vector<clargs::parser::token_kind> kinds;
+		for(const auto& t : tokens){
+			kinds.push_back(t.kind);
+			if(t.id == stop){
+				tokens.set_key_parsing(false);
+			}
+		}
+
+		tst::check_eq(kinds.size(), size_t(3), SL);
+		tst::check(kinds[2] == clargs::parser::token_kind::non_key, SL);
+	});
+
+	suite.add("error_stops_reading", []{
+		clargs::parser p;
+
+		p.add('a', "description", clargs::value_kind::none);
+
+		std::vector<std::string_view> args = {"-a", "-ab", "-a"};
+
+		auto tokens = p.tokens(utki::make_span(args));
+
+		size_t num_tokens = 0;
+		for([[maybe_unused]] const auto& t : tokens){
+			++num_tokens;
+		}
+
+		tst::check_eq(num_tokens, size_t(2), SL);
+		tst::check(tokens.error().code == clargs::error_code::unknown_argument, SL);
+		tst::check_eq(tokens.error().argument_index, size_t(1), SL);
+		tst::check_eq(tokens.error().offset, size_t(2), SL);
+	});
+});
+}
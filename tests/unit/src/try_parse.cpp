@@ -0,0 +1,117 @@
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include <clargs/parser.hpp>
+
+using namespace std::string_literals;
+using namespace std::string_view_literals;
+
+namespace{
+const tst::set set("try_parse", [](tst::suite& suite){
+	suite.add("successful_parsing_returns_no_error", []{
+		clargs::parser p;
+
+		bool a = false;
+		std::string b;
+		p.add('a', "description", [&a](){a = true;});
+		p.add("bbb", "description", [&b](std::string_view v){b = v;});
+
+		std::vector<std::string_view> args = {"-a", "first", "--bbb=value", "second"};
+
+		std::vector<std::string_view> non_key;
+		auto error = p.try_parse(utki::make_span(args), non_key);
+
+		tst::check(!error, SL);
+		tst::check(error.code == clargs::error_code::none, SL);
+		tst::check(a, SL);
+		tst::check_eq(b, "value"s, SL);
+		tst::check_eq(non_key.size(), size_t(2), SL);
+		tst::check_eq(non_key[0], "first"sv, SL);
+		tst::check_eq(non_key[1], "second"sv, SL);
+	});
+
+	suite.add("errors_are_reported", []{
+		struct test_case{
+			std::vector<std::string_view> args;
+			clargs::error_code code;
+			size_t argument_index;
+			size_t offset;
+			std::string message;
+		};
+
+		const std::vector<test_case> cases = {
+			{{"-a", "--unknown"}, clargs::error_code::unknown_argument, 1, 2, "unknown argument: --unknown"},
+			{{"-axa"}, clargs::error_code::unknown_argument, 0, 2, "unknown argument: -axa"},
+			{{"--aaa=1"}, clargs::error_code::unexpected_value, 0, 5, "key argument 'aaa' is a boolean argument and cannot have value"},
+			{{"--number"}, clargs::error_code::missing_value, 0, 8, "key argument 'number' requires value"},
+			{{"-a", "-n"}, clargs::error_code::missing_value, 1, 2, "argument 'n' requires value"},
+			{{"--number=x1"}, clargs::error_code::invalid_value, 0, 9, "invalid value of argument 'number': x1"},
+			{{"-n", "-1"}, clargs::error_code::invalid_value, 1, 0, "invalid value of argument 'n': -1"},
+			{{"-an300"}, clargs::error_code::value_out_of_range, 0, 3, "value of argument 'n' is out of range: 300"}
+		};
+
+		for(const auto& c : cases){
+			clargs::parser p;
+
+			uint8_t number = 0;
+			p.add('a', "aaa", "description", [](){});
+			p.add('n', "number", "description", number);
+
+			auto args = c.args;
+
+			std::vector<std::string_view> non_key;
+			auto error = p.try_parse(utki::make_span(args), non_key);
+
+			tst::check(bool(error), SL) << "message = " << c.message;
+			tst::check(error.code == c.code, SL) << "message = " << c.message;
+			tst::check_eq(error.argument_index, c.argument_index, SL) << "message = " << c.message;
+			tst::check_eq(error.offset, c.offset, SL) << "message = " << c.message;
+			tst::check_eq(error.message(), c.message, SL);
+		}
+	});
+
+	suite.add("handler_exception_is_caught", []{
+		clargs::parser p;
+
+		p.add('a', "description", [](){throw std::runtime_error("handler error");});
+
+		std::vector<std::string_view> args = {"first", "-a"};
+
+		std::vector<std::string_view> non_key;
+		auto error = p.try_parse(utki::make_span(args), non_key);
+
+		tst::check(error.code == clargs::error_code::exception_thrown, SL);
+		tst::check_eq(error.argument_index, size_t(1), SL);
+		tst::check(bool(error.exception), SL);
+
+		bool exception_caught = false;
+		try{
+			std::rethrow_exception(error.exception);
+		}catch(std::runtime_error& e){
+			exception_caught = true;
+			tst::check_eq(e.what(), "handler error"s, SL);
+		}
+		tst::check(exception_caught, SL);
+	});
+
+	suite.add("throwing_parse_reports_same_message", []{
+		clargs::parser p;
+
+		p.add('a', "description", [](){});
+
+		std::vector<std::string_view> args = {"-ab"};
+
+		std::vector<std::string_view> non_key;
+		auto error = p.try_parse(utki::make_span(args), non_key);
+
+		bool exception_caught = false;
+		try{
+			p.parse(utki::make_span(args));
+		}catch(std::invalid_argument& e){
+			exception_caught = true;
+			tst::check_eq(e.what(), error.message(), SL);
+		}
+		tst::check(exception_caught, SL);
+	});
+});
+}
@@ -0,0 +1,114 @@
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include <clargs/parser.hpp>
+
+using namespace std::string_literals;
+
+namespace{
+enum class color{
+	red,
+	green,
+	blue
+};
+
+const clargs::enum_names<color, 3> color_names = {{
+	{"red", color::red},
+	{"green", color::green},
+	{"blue", color::blue}
+}};
+}
+
+namespace{
+const tst::set set("value_binding", [](tst::suite& suite){
+	suite.add("values_are_converted_and_stored", []{
+		clargs::parser p;
+
+		int64_t count = 0;
+		unsigned short port = 0;
+		double ratio = 0;
+		std::string name;
+		bool verbose = false;
+		bool fast = true;
+		color c = color::red;
+
+		p.add('n', "count", "description", count);
+		p.add('p', "description", port);
+		p.add("ratio", "description", ratio);
+		p.add('N', "name", "description", name);
+		p.add('v', "verbose", "description", verbose);
+		p.add("fast", "description", fast);
+		p.add('c', "color", "description", c, color_names);
+
+		std::vector<std::string_view> args = {
+			"-n", "-1234567890123",
+			"-p8080",
+			"--ratio=0.25",
+			"--name=hello",
+			"-v",
+			"--fast=no",
+			"--color=blue"
+		};
+
+		p.parse(utki::make_span(args));
+
+		tst::check_eq(count, int64_t(-1234567890123), SL) << "count = " << count;
+		tst::check_eq(port, (unsigned short)(8080), SL) << "port = " << port;
+		tst::check_eq(ratio, 0.25, SL) << "ratio = " << ratio;
+		tst::check_eq(name, "hello"s, SL) << "name = " << name;
+		tst::check(verbose, SL);
+		tst::check(!fast, SL);
+		tst::check(c == color::blue, SL);
+	});
+
+	suite.add("invalid_values_throw", []{
+		clargs::parser p;
+
+		int count = 0;
+		unsigned char byte = 0;
+		color c = color::red;
+
+		p.add('n', "count", "description", count);
+		p.add("byte", "description", byte);
+		p.add("color", "description", c, color_names);
+
+		std::vector<std::pair<std::vector<std::string_view>, std::string>> cases = {
+			{{"-n12a"}, "invalid value of argument 'n': 12a"},
+			{{"--count="}, "invalid value of argument 'count': "},
+			{{"--byte=256"}, "value of argument 'byte' is out of range: 256"},
+			{{"--color=yellow"}, "invalid value of argument 'color': yellow"},
+			{{"--count"}, "key argument 'count' requires value"}
+		};
+
+		for(auto& c : cases){
+			bool exception_caught = false;
+			try{
+				p.parse(utki::make_span(c.first));
+			}catch(std::invalid_argument& e){
+				exception_caught = true;
+				tst::check_eq(std::string(e.what()), c.second, SL) << "e.what() = " << e.what();
+			}
+			tst::check(exception_caught, SL) << c.second;
+		}
+
+		tst::check_eq(count, 0, SL);
+		tst::check_eq(byte, (unsigned char)(0), SL);
+	});
+
+	suite.add("description_of_bound_arguments", []{
+		clargs::parser p;
+
+		int count = 0;
+		bool verbose = false;
+
+		p.add('n', "count", "count description", count);
+		p.add('v', "verbose", "verbose description", verbose);
+
+		auto expected =
+			"  -n, --count=VALUE           count description\n"
+			"  -v, --verbose[=VALUE]       verbose description\n"s;
+
+		tst::check_eq(p.description(), expected, SL) << "description =\n" << p.description();
+	});
+});
+}